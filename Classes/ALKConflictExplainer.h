@@ -0,0 +1,131 @@
+//  ALKConflictExplainer.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+/**
+ A set of required constraints that cannot be satisfied together.
+ 
+ Removing any single member resolves the conflict, so the set is minimal.
+ 
+ @since 1.1.0
+ */
+@interface ALKConstraintConflict : NSObject
+
+/**
+ The constraint that could not be added to the others.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, strong, readonly, nonnull) NSLayoutConstraint * constraint;
+
+/**
+ The conflicting constraints including `constraint`, in the order they have
+ been added to the explainer.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, copy, readonly, nonnull) NSArray<NSLayoutConstraint *> * constraints;
+
+/**
+ One label per member of the conflict: the name a constraint has been
+ registered with using `alk_addConstraint:withName:`, otherwise its
+ description. Views with `translatesAutoresizingMaskIntoConstraints` keep
+ their frame, which is listed as a member of its own.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, copy, readonly, nonnull) NSArray<NSString *> * labels;
+
+@end
+
+/**
+ The `ALKConflictExplainer` finds out which required constraints of a view
+ subtree contradict each other, without dropping constraints and laying out
+ again until the layout succeeds.
+ 
+ It keeps the required equalities of the subtree in reduced row echelon form,
+ every row remembering the combination of constraints it has been derived
+ from. A constraint that reduces to `0 == c` with `c != 0` conflicts, and the
+ constraints of that combination are exactly the minimal conflicting set. A
+ constraint that does not conflict is kept, so adding one costs only the rows
+ that share its variables.
+ 
+    ALKConflictExplainer *explainer = [ALKConflictExplainer explainerForView:self.view];
+    ALKConstraintConflict *conflict = [explainer explainConstraint:widthConstraint];
+    if (conflict) NSLog(@"%@", conflict.labels);
+ 
+ Only required equalities are considered. Inequalities and optional
+ constraints cannot make a layout unsatisfiable on their own in the common
+ cases and are skipped, as are margin and baseline attributes because their
+ offset depends on the content of the view. Leading and trailing are treated
+ as left and right.
+ 
+ Views with `translatesAutoresizingMaskIntoConstraints` keep their frame.
+ Every other view, including the root of the subtree, is only placed by its
+ constraints.
+ 
+ @since 1.1.0
+ */
+@interface ALKConflictExplainer : NSObject
+
+/**
+ Creates an explainer loaded with the active constraints of `view` and its
+ subviews.
+ 
+ @param view The root of the subtree.
+ 
+ @since 1.1.0
+ */
++ (nonnull instancetype) explainerForView:(nonnull UIView *) view;
+
+/**
+ The conflicts among the constraints of the subtree that have been found while
+ loading it. The last constraint of every conflict has not been kept.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, copy, readonly, nonnull) NSArray<ALKConstraintConflict *> * conflicts;
+
+/**
+ The number of independent equalities that are currently kept.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger rowCount;
+
+/**
+ Checks whether `constraint` can be satisfied together with the constraints
+ the explainer already knows. The constraint does not need to be active.
+ 
+ @param constraint The constraint to add.
+ 
+ @return The conflict or `nil` if the constraint is compatible (or is not a
+ required equality). A compatible constraint is kept for later calls.
+ 
+ @since 1.1.0
+ */
+- (nullable ALKConstraintConflict *) explainConstraint:(nonnull NSLayoutConstraint *) constraint;
+
+@end
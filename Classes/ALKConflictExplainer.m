@@ -0,0 +1,421 @@
+//  ALKConflictExplainer.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKConflictExplainer.h"
+#import "UIView+ALKNamedConstraints.h"
+
+/** Coefficients below this are treated as zero. */
+static double const kALKConflictEpsilon = 1e-9;
+
+/** `0 == c` is a conflict if `c` exceeds this (in points). */
+static double const kALKConflictTolerance = 1e-3;
+
+/** Every item has four variables: minX, width, minY and height. */
+typedef NS_ENUM(NSUInteger, ALKConflictVariable) {
+    ALKConflictVariableMinX,
+    ALKConflictVariableWidth,
+    ALKConflictVariableMinY,
+    ALKConflictVariableHeight,
+    ALKConflictVariableCount
+};
+
+/**
+ A row `sum(terms) == constant`, derived from the sources with the given
+ coefficients. Kept rows are normalized to a coefficient of 1 on their pivot.
+ */
+@interface ALKConflictRow : NSObject
+
+@property (nonatomic, strong, nonnull) NSMutableDictionary<NSNumber *, NSNumber *> * terms;
+@property (nonatomic, assign) double constant;
+@property (nonatomic, strong, nonnull) NSMutableDictionary<NSNumber *, NSNumber *> * sources;
+
+@end
+
+@implementation ALKConflictRow
+
+- (nonnull instancetype) init {
+    self = [super init];
+    if (self) {
+        _terms = [NSMutableDictionary dictionary];
+        _sources = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+@end
+
+@interface ALKConstraintConflict ()
+
+@property (nonatomic, strong, readwrite, nonnull) NSLayoutConstraint * constraint;
+@property (nonatomic, copy, readwrite, nonnull) NSArray<NSLayoutConstraint *> * constraints;
+@property (nonatomic, copy, readwrite, nonnull) NSArray<NSString *> * labels;
+
+@end
+
+@implementation ALKConstraintConflict
+
+- (nonnull NSString *) description {
+    return [NSString stringWithFormat:@"<%@: %p; %@>", NSStringFromClass([self class]), self,
+            [self.labels componentsJoinedByString:@", "]];
+}
+
+@end
+
+@interface ALKConflictExplainer ()
+
+@property (nonatomic, copy, readwrite, nonnull) NSArray<ALKConstraintConflict *> * conflicts;
+
+@end
+
+@implementation ALKConflictExplainer {
+    UIView *_root;
+    
+    /// kept rows, indexed by `_pivots` and `_occurrences`
+    NSMutableArray<ALKConflictRow *> *_rows;
+    /// column -> index of the row it is the pivot of
+    NSMutableDictionary<NSNumber *, NSNumber *> *_pivots;
+    /// column -> indexes of the rows it occurs in
+    NSMutableDictionary<NSNumber *, NSMutableIndexSet *> *_occurrences;
+    
+    /// item -> index, four columns per item
+    NSMapTable *_items;
+    /// source index -> constraint or label of a fixed frame
+    NSMutableArray<id> *_sources;
+    /// constraint -> registered name
+    NSMutableDictionary<NSValue *, NSString *> *_names;
+}
+
++ (nonnull instancetype) explainerForView:(nonnull UIView *) view {
+    ALKConflictExplainer *explainer = [[ALKConflictExplainer alloc] initWithRoot:view];
+    [explainer loadView:view];
+    return explainer;
+}
+
+- (nonnull instancetype) initWithRoot:(nonnull UIView *) root {
+    self = [super init];
+    if (self) {
+        _root = root;
+        _rows = [NSMutableArray array];
+        _pivots = [NSMutableDictionary dictionary];
+        _occurrences = [NSMutableDictionary dictionary];
+        _items = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                       valueOptions:NSPointerFunctionsStrongMemory];
+        _sources = [NSMutableArray array];
+        _names = [NSMutableDictionary dictionary];
+        _conflicts = @[];
+    }
+    return self;
+}
+
+- (NSUInteger) rowCount {
+    return _rows.count;
+}
+
+#pragma mark - Loading
+
+- (void) loadView:(nonnull UIView *) root {
+    NSMutableArray<UIView *> *views = [NSMutableArray array];
+    NSMutableArray<UIView *> *stack = [NSMutableArray arrayWithObject:root];
+    while (stack.count > 0) {
+        UIView *view = [stack lastObject];
+        [stack removeLastObject];
+        [views addObject:view];
+        [self collectNamesOfView:view];
+        [stack addObjectsFromArray:[[view.subviews reverseObjectEnumerator] allObjects]];
+    }
+    
+    NSMutableArray *conflicts = [NSMutableArray array];
+    for (UIView *view in views) {
+        for (NSLayoutConstraint *lc in view.constraints) {
+            // frames of autoresizing views are added as a whole when the view is first used
+            if (!lc.active || isAutoresizingConstraint(lc)) continue;
+            
+            ALKConstraintConflict *conflict = [self explainConstraint:lc];
+            if (conflict) [conflicts addObject:conflict];
+        }
+    }
+    self.conflicts = conflicts;
+}
+
+- (void) collectNamesOfView:(nonnull UIView *) view {
+    // looking names up must not leave a table on every view the explainer visits
+    [view.alk_existingNamedConstraints enumerateKeysAndObjectsUsingBlock:^(NSString *name, id obj, BOOL *stop) {
+        if ([obj isKindOfClass:[NSLayoutConstraint class]]) {
+            self->_names[[NSValue valueWithNonretainedObject:obj]] = name;
+        }
+    }];
+}
+
+#pragma mark - Explaining
+
+- (nullable ALKConstraintConflict *) explainConstraint:(nonnull NSLayoutConstraint *) constraint {
+    if (constraint.relation != NSLayoutRelationEqual || constraint.priority < UILayoutPriorityRequired) return nil;
+    if (!isSupportedAttribute(constraint.firstAttribute) || !isSupportedAttribute(constraint.secondAttribute)) return nil;
+    
+    // index the items first, this may add the fixed frames of autoresizing views
+    NSUInteger first = [self indexOfItem:constraint.firstItem];
+    NSUInteger second = constraint.secondItem ? [self indexOfItem:constraint.secondItem] : NSNotFound;
+    
+    // first.attribute - multiplier * second.attribute == constant
+    ALKConflictRow *row = [[ALKConflictRow alloc] init];
+    addAttribute(row, first, constraint.firstAttribute, 1.0);
+    if (second != NSNotFound) {
+        addAttribute(row, second, constraint.secondAttribute, -constraint.multiplier);
+    }
+    row.constant = constraint.constant;
+    
+    return [self addRow:row source:constraint];
+}
+
+- (nullable ALKConstraintConflict *) addRow:(nonnull ALKConflictRow *) row source:(nonnull id) source {
+    NSNumber *sourceIndex = @(_sources.count);
+    [_sources addObject:source];
+    row.sources[sourceIndex] = @1.0;
+    
+    // every kept row is the only one containing its pivot, so one pass reduces the new row
+    for (NSNumber *column in [row.terms allKeys]) {
+        NSNumber *pivotRow = _pivots[column];
+        NSNumber *factor = row.terms[column];
+        if (nil == pivotRow || nil == factor) continue;
+        subtractRow(row, factor.doubleValue, _rows[pivotRow.unsignedIntegerValue], nil, NSNotFound);
+    }
+    
+    if (row.terms.count == 0) {
+        if (fabs(row.constant) <= kALKConflictTolerance) return nil; // redundant, but consistent
+        return [self conflictOfRow:row];
+    }
+    
+    // pivot on the largest coefficient to keep the rows well conditioned
+    __block NSNumber *pivot = nil;
+    __block double largest = 0.0;
+    [row.terms enumerateKeysAndObjectsUsingBlock:^(NSNumber *column, NSNumber *coefficient, BOOL *stop) {
+        if (fabs(coefficient.doubleValue) > largest) {
+            largest = fabs(coefficient.doubleValue);
+            pivot = column;
+        }
+    }];
+    scaleRow(row, 1.0 / row.terms[pivot].doubleValue);
+    
+    // eliminate the pivot from every other row
+    NSUInteger rowIndex = _rows.count;
+    NSIndexSet *containing = [_occurrences[pivot] copy];
+    [containing enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        ALKConflictRow *other = self->_rows[index];
+        subtractRow(other, other.terms[pivot].doubleValue, row, self->_occurrences, index);
+    }];
+    
+    [_rows addObject:row];
+    _pivots[pivot] = @(rowIndex);
+    for (NSNumber *column in row.terms) {
+        [occurrencesOf(_occurrences, column) addIndex:rowIndex];
+    }
+    
+    return nil;
+}
+
+- (nonnull ALKConstraintConflict *) conflictOfRow:(nonnull ALKConflictRow *) row {
+    NSArray<NSNumber *> *members = [[row.sources keysOfEntriesPassingTest:^BOOL(NSNumber *source, NSNumber *coefficient, BOOL *stop) {
+        return fabs(coefficient.doubleValue) > kALKConflictEpsilon;
+    }] allObjects];
+    members = [members sortedArrayUsingSelector:@selector(compare:)];
+    
+    NSMutableArray *constraints = [NSMutableArray arrayWithCapacity:members.count];
+    NSMutableArray *labels = [NSMutableArray arrayWithCapacity:members.count];
+    for (NSNumber *member in members) {
+        id source = _sources[member.unsignedIntegerValue];
+        if ([source isKindOfClass:[NSLayoutConstraint class]]) {
+            [constraints addObject:source];
+            [labels addObject:[self labelOfConstraint:source]];
+        } else {
+            [labels addObject:source];
+        }
+    }
+    
+    ALKConstraintConflict *conflict = [[ALKConstraintConflict alloc] init];
+    conflict.constraint = [constraints lastObject];
+    conflict.constraints = constraints;
+    conflict.labels = labels;
+    return conflict;
+}
+
+#pragma mark - Items
+
+- (NSUInteger) indexOfItem:(nonnull id) item {
+    NSNumber *index = [_items objectForKey:item];
+    if (index) return index.unsignedIntegerValue;
+    
+    NSUInteger newIndex = _items.count;
+    [_items setObject:@(newIndex) forKey:item];
+    
+    // only views that keep their autoresizing frame are fixed, the root or a view
+    // without superview is as free as its constraints make it
+    if ([item isKindOfClass:[UIView class]] && ((UIView *)item).translatesAutoresizingMaskIntoConstraints) {
+        [self addFrameOfView:(UIView *)item index:newIndex];
+    }
+    
+    return newIndex;
+}
+
+- (void) addFrameOfView:(nonnull UIView *) view index:(NSUInteger) index {
+    // one coordinate space for all items, the one of the topmost superview
+    CGRect frame = [view convertRect:view.bounds toView:nil];
+    NSString *label = [NSString stringWithFormat:@"frame of <%@: %p>", NSStringFromClass([view class]), view];
+    
+    const double values[ALKConflictVariableCount] = {
+        CGRectGetMinX(frame), CGRectGetWidth(frame), CGRectGetMinY(frame), CGRectGetHeight(frame)
+    };
+    for (NSUInteger variable = 0; variable < ALKConflictVariableCount; variable++) {
+        ALKConflictRow *row = [[ALKConflictRow alloc] init];
+        row.terms[@(index * ALKConflictVariableCount + variable)] = @1.0;
+        row.constant = values[variable];
+        [self addRow:row source:label];
+    }
+}
+
+- (nonnull NSString *) labelOfConstraint:(nonnull NSLayoutConstraint *) constraint {
+    NSString *name = _names[[NSValue valueWithNonretainedObject:constraint]];
+    if (name) return name;
+    
+    // constraints added later are registered on one of their items or a superview of it
+    for (id item in @[ constraint.firstItem ?: [NSNull null], constraint.secondItem ?: [NSNull null] ]) {
+        if (![item isKindOfClass:[UIView class]]) continue;
+        for (UIView *view = item; view; view = view.superview) {
+            [self collectNamesOfView:view];
+        }
+    }
+    
+    return _names[[NSValue valueWithNonretainedObject:constraint]] ?: constraint.identifier ?: constraint.description;
+}
+
+#pragma mark - Functions
+
+static BOOL isAutoresizingConstraint(NSLayoutConstraint * _Nonnull constraint) {
+    return [NSStringFromClass([constraint class]) isEqualToString:@"NSAutoresizingMaskLayoutConstraint"];
+}
+
+static BOOL isSupportedAttribute(NSLayoutAttribute attribute) {
+    switch (attribute) {
+        case NSLayoutAttributeLeft:
+        case NSLayoutAttributeRight:
+        case NSLayoutAttributeTop:
+        case NSLayoutAttributeBottom:
+        case NSLayoutAttributeLeading:
+        case NSLayoutAttributeTrailing:
+        case NSLayoutAttributeWidth:
+        case NSLayoutAttributeHeight:
+        case NSLayoutAttributeCenterX:
+        case NSLayoutAttributeCenterY:
+        case NSLayoutAttributeNotAnAttribute:
+            return YES;
+        default:
+            return NO;
+    }
+}
+
+static void addTerm(ALKConflictRow * _Nonnull row, NSUInteger item, ALKConflictVariable variable, double coefficient) {
+    NSNumber *column = @(item * ALKConflictVariableCount + variable);
+    double value = row.terms[column].doubleValue + coefficient;
+    row.terms[column] = fabs(value) > kALKConflictEpsilon ? @(value) : nil;
+}
+
+static void addAttribute(ALKConflictRow * _Nonnull row, NSUInteger item, NSLayoutAttribute attribute, double coefficient) {
+    switch (attribute) {
+        case NSLayoutAttributeLeft:
+        case NSLayoutAttributeLeading:
+            addTerm(row, item, ALKConflictVariableMinX, coefficient);
+            break;
+        case NSLayoutAttributeRight:
+        case NSLayoutAttributeTrailing:
+            addTerm(row, item, ALKConflictVariableMinX, coefficient);
+            addTerm(row, item, ALKConflictVariableWidth, coefficient);
+            break;
+        case NSLayoutAttributeCenterX:
+            addTerm(row, item, ALKConflictVariableMinX, coefficient);
+            addTerm(row, item, ALKConflictVariableWidth, coefficient * 0.5);
+            break;
+        case NSLayoutAttributeWidth:
+            addTerm(row, item, ALKConflictVariableWidth, coefficient);
+            break;
+        case NSLayoutAttributeTop:
+            addTerm(row, item, ALKConflictVariableMinY, coefficient);
+            break;
+        case NSLayoutAttributeBottom:
+            addTerm(row, item, ALKConflictVariableMinY, coefficient);
+            addTerm(row, item, ALKConflictVariableHeight, coefficient);
+            break;
+        case NSLayoutAttributeCenterY:
+            addTerm(row, item, ALKConflictVariableMinY, coefficient);
+            addTerm(row, item, ALKConflictVariableHeight, coefficient * 0.5);
+            break;
+        case NSLayoutAttributeHeight:
+            addTerm(row, item, ALKConflictVariableHeight, coefficient);
+            break;
+        default:
+            break;
+    }
+}
+
+static void scaleRow(ALKConflictRow * _Nonnull row, double factor) {
+    for (NSNumber *column in [row.terms allKeys]) {
+        row.terms[column] = @(row.terms[column].doubleValue * factor);
+    }
+    for (NSNumber *source in [row.sources allKeys]) {
+        row.sources[source] = @(row.sources[source].doubleValue * factor);
+    }
+    row.constant *= factor;
+}
+
+/**
+ `row -= factor * other`. If `occurrences` is given, the columns that appear
+ in or vanish from `row` are updated for the row at `rowIndex`.
+ */
+static void subtractRow(ALKConflictRow * _Nonnull row, double factor, ALKConflictRow * _Nonnull other,
+                        NSMutableDictionary<NSNumber *, NSMutableIndexSet *> * _Nullable occurrences, NSUInteger rowIndex) {
+    [other.terms enumerateKeysAndObjectsUsingBlock:^(NSNumber *column, NSNumber *coefficient, BOOL *stop) {
+        double value = row.terms[column].doubleValue - factor * coefficient.doubleValue;
+        if (fabs(value) > kALKConflictEpsilon) {
+            if (occurrences && nil == row.terms[column]) [occurrencesOf(occurrences, column) addIndex:rowIndex];
+            row.terms[column] = @(value);
+        } else {
+            if (occurrences && nil != row.terms[column]) [occurrences[column] removeIndex:rowIndex];
+            [row.terms removeObjectForKey:column];
+        }
+    }];
+    [other.sources enumerateKeysAndObjectsUsingBlock:^(NSNumber *source, NSNumber *coefficient, BOOL *stop) {
+        double value = row.sources[source].doubleValue - factor * coefficient.doubleValue;
+        row.sources[source] = fabs(value) > kALKConflictEpsilon ? @(value) : nil;
+    }];
+    row.constant -= factor * other.constant;
+}
+
+static NSMutableIndexSet * _Nonnull occurrencesOf(NSMutableDictionary<NSNumber *, NSMutableIndexSet *> * _Nonnull occurrences, NSNumber * _Nonnull column) {
+    NSMutableIndexSet *rows = occurrences[column];
+    if (nil == rows) {
+        rows = [NSMutableIndexSet indexSet];
+        occurrences[column] = rows;
+    }
+    return rows;
+}
+
+@end
@@ -0,0 +1,104 @@
+//  ALKConstraintGraph.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+/**
+ The `ALKConstraintGraph` is a snapshot of the constraints of a view subtree
+ that can be exported to inspect which parts of a layout are expensive.
+ 
+ Every view of the subtree (plus any view or layout guide outside of it that a
+ constraint refers to) becomes a node; every constraint installed in the
+ subtree becomes an edge from its first to its second item. Constraints
+ without a second item (e.g. a fixed width) are edges from a node to itself.
+ 
+    ALKConstraintGraph *graph = [ALKConstraintGraph graphOfView:self.view measuringLayout:YES];
+    [graph.DOTRepresentation writeToFile:@"/tmp/layout.dot" atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+ 
+ Nodes are annotated with the number of constraints that touch them, the
+ number of constraints they own and whether their layout is ambiguous. Edges
+ carry the attributes, relation, multiplier, constant, priority and, if
+ registered, the name of their constraint. The JSON export uses stable node
+ ids and sorted keys so that two exports can be diffed as text.
+ 
+ @since 1.1.0
+ */
+@interface ALKConstraintGraph : NSObject
+
+/**
+ Creates a graph of the constraints of `view` and its subviews.
+ 
+ @param view The root of the exported subtree.
+ @param measuringLayout If `YES`, every view of the subtree is marked as
+ needing layout, the subtree is laid out once and the time it took is stored
+ in `layoutTime`. The layout engine keeps its solution between passes, so
+ this measures a warm pass over the current constraints, not a solve from
+ scratch.
+ 
+ @since 1.1.0
+ */
++ (nonnull instancetype) graphOfView:(nonnull UIView *) view measuringLayout:(BOOL) measuringLayout;
+
+/**
+ The nodes, each a dictionary with the keys `id`, `class`, `frame`,
+ `external`, `ambiguous`, `degree` (constraints touching the node) and
+ `installed` (constraints installed on the node).
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, copy, readonly, nonnull) NSArray<NSDictionary<NSString *, id> *> * nodes;
+
+/**
+ The edges, each a dictionary with the keys `from`, `to`, `attribute`,
+ `relatedAttribute`, `relation`, `multiplier`, `constant`, `priority`,
+ `kind`, `active` and optionally `name`.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, copy, readonly, nonnull) NSArray<NSDictionary<NSString *, id> *> * edges;
+
+/**
+ The time a layout pass of the whole subtree took or `0` if the graph has
+ been created without measuring the layout.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) CFTimeInterval layoutTime;
+
+/**
+ The graph in the DOT language of Graphviz. Nodes are shaded by their degree
+ so that the most constrained views stand out.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, copy, readonly, nonnull) NSString * DOTRepresentation;
+
+/**
+ The graph as a JSON object with the keys `nodes`, `edges` and `layoutTime`.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, copy, readonly, nonnull) NSData * JSONRepresentation;
+
+@end
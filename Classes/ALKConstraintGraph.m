@@ -0,0 +1,268 @@
+//  ALKConstraintGraph.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "ALKConstraintGraph.h"
+#import "UIView+ALKNamedConstraints.h"
+
+@interface ALKConstraintGraph ()
+
+@property (nonatomic, copy, readwrite, nonnull) NSArray<NSDictionary<NSString *, id> *> * nodes;
+@property (nonatomic, copy, readwrite, nonnull) NSArray<NSDictionary<NSString *, id> *> * edges;
+@property (nonatomic, assign, readwrite) CFTimeInterval layoutTime;
+
+@end
+
+@implementation ALKConstraintGraph
+
++ (nonnull instancetype) graphOfView:(nonnull UIView *) view measuringLayout:(BOOL) measuringLayout {
+    ALKConstraintGraph *graph = [[ALKConstraintGraph alloc] init];
+    
+    if (measuringLayout) {
+        setNeedsLayoutOfSubtree(view);
+        
+        CFTimeInterval start = CACurrentMediaTime();
+        [view layoutIfNeeded];
+        graph.layoutTime = CACurrentMediaTime() - start;
+    }
+    
+    [graph collectView:view];
+    return graph;
+}
+
+- (nonnull instancetype) init {
+    self = [super init];
+    if (self) {
+        self.nodes = @[];
+        self.edges = @[];
+    }
+    return self;
+}
+
+#pragma mark - Collecting
+
+- (void) collectView:(nonnull UIView *) root {
+    // depth first, so node ids are stable for an unchanged hierarchy
+    NSMutableArray<UIView *> *views = [NSMutableArray array];
+    NSMutableArray<UIView *> *stack = [NSMutableArray arrayWithObject:root];
+    while (stack.count > 0) {
+        UIView *view = [stack lastObject];
+        [stack removeLastObject];
+        [views addObject:view];
+        [stack addObjectsFromArray:[[view.subviews reverseObjectEnumerator] allObjects]];
+    }
+    
+    // the views of the subtree come first, items outside of it are appended on first use
+    NSMapTable *indexes = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                                valueOptions:NSPointerFunctionsStrongMemory];
+    NSMutableArray<id> *items = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *degrees = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *installed = [NSMutableArray array];
+    
+    NSUInteger (^indexOfItem)(id) = ^NSUInteger(id item) {
+        NSNumber *index = [indexes objectForKey:item];
+        if (nil == index) {
+            index = @(items.count);
+            [indexes setObject:index forKey:item];
+            [items addObject:item];
+            [degrees addObject:@0];
+            [installed addObject:@0];
+        }
+        return index.unsignedIntegerValue;
+    };
+    
+    for (UIView *view in views) {
+        indexOfItem(view);
+    }
+    
+    // a name is registered on the target view of its constraint, which is not
+    // necessarily the view it is installed on and may be an ancestor of the root
+    NSMutableDictionary<NSValue *, NSString *> *names = [NSMutableDictionary dictionary];
+    for (UIView *view in views) {
+        addNamesOfConstraints(view, names);
+    }
+    for (UIView *ancestor = root.superview; ancestor; ancestor = ancestor.superview) {
+        addNamesOfConstraints(ancestor, names);
+    }
+    
+    NSMutableArray *edges = [NSMutableArray array];
+    for (UIView *view in views) {
+        installed[indexOfItem(view)] = @(view.constraints.count);
+        
+        for (NSLayoutConstraint *lc in view.constraints) {
+            NSUInteger from = indexOfItem(lc.firstItem);
+            NSUInteger to = lc.secondItem ? indexOfItem(lc.secondItem) : from;
+            
+            degrees[from] = @(degrees[from].unsignedIntegerValue + 1);
+            if (to != from) {
+                degrees[to] = @(degrees[to].unsignedIntegerValue + 1);
+            }
+            
+            NSMutableDictionary *edge = [@{ @"from": nodeID(from),
+                                            @"to": nodeID(to),
+                                            @"attribute": attributeName(lc.firstAttribute),
+                                            @"relatedAttribute": attributeName(lc.secondAttribute),
+                                            @"relation": relationName(lc.relation),
+                                            @"multiplier": @(lc.multiplier),
+                                            @"constant": @(lc.constant),
+                                            @"priority": @(lc.priority),
+                                            @"kind": constraintKind(lc),
+                                            @"active": @(lc.active) } mutableCopy];
+            
+            NSString *name = names[[NSValue valueWithNonretainedObject:lc]];
+            if (name) edge[@"name"] = name;
+            
+            [edges addObject:edge];
+        }
+    }
+    
+    NSMutableArray *nodes = [NSMutableArray arrayWithCapacity:items.count];
+    [items enumerateObjectsUsingBlock:^(id item, NSUInteger idx, BOOL *stop) {
+        BOOL isView = [item isKindOfClass:[UIView class]];
+        CGRect frame = CGRectZero;
+        if (isView) {
+            frame = ((UIView *)item).frame;
+        } else if ([item respondsToSelector:@selector(layoutFrame)]) {
+            frame = [(UILayoutGuide *)item layoutFrame];
+        }
+        
+        [nodes addObject:@{ @"id": nodeID(idx),
+                            @"class": NSStringFromClass([item class]),
+                            @"frame": @[ @(frame.origin.x), @(frame.origin.y), @(frame.size.width), @(frame.size.height) ],
+                            @"external": @(idx >= views.count),
+                            @"ambiguous": @(isView && [(UIView *)item hasAmbiguousLayout]),
+                            @"degree": degrees[idx],
+                            @"installed": installed[idx] }];
+    }];
+    
+    self.nodes = nodes;
+    self.edges = edges;
+}
+
+#pragma mark - Export
+
+- (nonnull NSString *) DOTRepresentation {
+    NSUInteger maximumDegree = 1;
+    for (NSDictionary *node in self.nodes) {
+        maximumDegree = MAX(maximumDegree, [node[@"degree"] unsignedIntegerValue]);
+    }
+    
+    NSMutableString *dot = [NSMutableString stringWithString:@"digraph ALKConstraintGraph {\n  node [shape=box, style=filled];\n"];
+    
+    for (NSDictionary *node in self.nodes) {
+        // white for unconstrained nodes up to red for the most constrained one
+        double heat = [node[@"degree"] doubleValue] / (double)maximumDegree;
+        [dot appendFormat:@"  %@ [label=\"%@\\n%@ constraints\", fillcolor=\"0.0 %.2f 1.0\"%@];\n",
+         node[@"id"], node[@"class"], node[@"degree"], heat, [node[@"external"] boolValue] ? @", style=\"filled,dashed\"" : @""];
+    }
+    
+    for (NSDictionary *edge in self.edges) {
+        NSString *label = [NSString stringWithFormat:@"%@ %@ %@ * %g + %g @%g",
+                           edge[@"attribute"], edge[@"relation"], edge[@"relatedAttribute"],
+                           [edge[@"multiplier"] doubleValue], [edge[@"constant"] doubleValue], [edge[@"priority"] doubleValue]];
+        if (edge[@"name"]) {
+            label = [NSString stringWithFormat:@"%@\\n%@", edge[@"name"], label];
+        }
+        [dot appendFormat:@"  %@ -> %@ [label=\"%@\"%@];\n", edge[@"from"], edge[@"to"],
+         [label stringByReplacingOccurrencesOfString:@"\"" withString:@"\\\""],
+         [edge[@"active"] boolValue] ? @"" : @", style=dotted"];
+    }
+    
+    [dot appendString:@"}\n"];
+    return dot;
+}
+
+- (nonnull NSData *) JSONRepresentation {
+    NSDictionary *graph = @{ @"nodes": self.nodes,
+                             @"edges": self.edges,
+                             @"layoutTime": @(self.layoutTime) };
+    
+    NSJSONWritingOptions options = NSJSONWritingPrettyPrinted;
+    if (@available(iOS 11, *)) {
+        options |= NSJSONWritingSortedKeys;
+    }
+    
+    return [NSJSONSerialization dataWithJSONObject:graph options:options error:NULL] ?: [NSData data];
+}
+
+#pragma mark - Functions
+
+static NSString * _Nonnull nodeID(NSUInteger index) {
+    return [NSString stringWithFormat:@"n%lu", (unsigned long)index];
+}
+
+static void setNeedsLayoutOfSubtree(UIView * _Nonnull root) {
+    NSMutableArray<UIView *> *stack = [NSMutableArray arrayWithObject:root];
+    while (stack.count > 0) {
+        UIView *view = [stack lastObject];
+        [stack removeLastObject];
+        [view setNeedsLayout];
+        [stack addObjectsFromArray:view.subviews];
+    }
+}
+
+static void addNamesOfConstraints(UIView * _Nonnull view, NSMutableDictionary<NSValue *, NSString *> * _Nonnull names) {
+    // exporting must not give every visited view a table of its own
+    [view.alk_existingNamedConstraints enumerateKeysAndObjectsUsingBlock:^(NSString *name, NSLayoutConstraint *lc, BOOL *stop) {
+        names[[NSValue valueWithNonretainedObject:lc]] = name;
+    }];
+}
+
+static NSString * _Nonnull attributeName(NSLayoutAttribute attribute) {
+    switch (attribute) {
+        case NSLayoutAttributeLeft:     return @"left";
+        case NSLayoutAttributeRight:    return @"right";
+        case NSLayoutAttributeTop:      return @"top";
+        case NSLayoutAttributeBottom:   return @"bottom";
+        case NSLayoutAttributeLeading:  return @"leading";
+        case NSLayoutAttributeTrailing: return @"trailing";
+        case NSLayoutAttributeWidth:    return @"width";
+        case NSLayoutAttributeHeight:   return @"height";
+        case NSLayoutAttributeCenterX:  return @"centerX";
+        case NSLayoutAttributeCenterY:  return @"centerY";
+        case NSLayoutAttributeBaseline: return @"baseline";
+        case NSLayoutAttributeNotAnAttribute: return @"none";
+        default: return [NSString stringWithFormat:@"%ld", (long)attribute];
+    }
+}
+
+static NSString * _Nonnull relationName(NSLayoutRelation relation) {
+    switch (relation) {
+        case NSLayoutRelationLessThanOrEqual:    return @"<=";
+        case NSLayoutRelationEqual:              return @"==";
+        case NSLayoutRelationGreaterThanOrEqual: return @">=";
+    }
+    return @"?";
+}
+
+static NSString * _Nonnull constraintKind(NSLayoutConstraint * _Nonnull constraint) {
+    // UIKit adds these on its own, they are rows in the solver all the same
+    NSString *className = NSStringFromClass([constraint class]);
+    if ([className isEqualToString:@"NSAutoresizingMaskLayoutConstraint"]) return @"autoresizing";
+    if ([className isEqualToString:@"NSContentSizeLayoutConstraint"]) return @"contentSize";
+    return @"constraint";
+}
+
+@end
@@ -0,0 +1,178 @@
+//  ALKConstraintPool.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+#import <AutoLayoutKit/ALKConstraints.h>
+
+/**
+ The `ALKConstraintPool` recycles the constraints created by
+ `+[ALKConstraints relayout:do:]`.
+ 
+ Every relayout of a view checks the constraints of its previous relayout
+ back into the pool. A newly declared relation that matches the items,
+ attributes, relation and multiplier of a pooled constraint reuses that
+ constraint and only rewrites its constant and priority instead of
+ allocating a new one. Pooled constraints that are not declared again are
+ deactivated and kept as spares, so a reused cell that switches between a few
+ layouts (e.g. in a heterogeneous feed) mostly reactivates constraints it
+ already owns.
+ 
+ Spares are dropped when the app receives a memory warning. The pool of a view
+ is owned by the view, so its constraints are released when the view goes away.
+ 
+ The pool is not thread-safe and must only be used from the main thread.
+ 
+ @since 1.1.0
+ */
+@interface ALKConstraintPool : NSObject
+
+/**
+ The pool that is used by `ALKConstraints`.
+ 
+ @since 1.1.0
+ */
++ (nonnull instancetype) sharedPool;
+
+/**
+ The maximum number of inactive spare constraints kept per view. Defaults to 32.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign) NSUInteger maximumSpareCount;
+
+/**
+ The number of declared relations that reused a pooled constraint, i.e. the
+ number of constraint allocations that have been saved.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger hitCount;
+
+/**
+ The number of declared relations that needed a new constraint.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger missCount;
+
+/**
+ `hitCount` relative to all declared relations, or 0 if nothing has been
+ declared yet.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) double hitRate;
+
+/**
+ The number of inactive spare constraints held by the pool.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger spareCount;
+
+/**
+ The number of pooled constraints that are in use.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger constraintCount;
+
+/**
+ The number of bytes held by the pool, including the spare constraints.
+ Constraints in use are not included.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) size_t memoryFootprint;
+
+/**
+ The number of bytes the pool holds for `view`, including its spare
+ constraints.
+ 
+ @since 1.1.0
+ */
+- (size_t) memoryFootprintOfView:(nonnull UIView *) view;
+
+/**
+ Resets `hitCount` and `missCount`.
+ 
+ @since 1.1.0
+ */
+- (void) resetStatistics;
+
+/**
+ Drops all spare constraints. Constraints that are in use stay active.
+ 
+ @since 1.1.0
+ */
+- (void) purge;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Relayout Sessions
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ Checks the constraints of the previous relayout of `view` back into the pool.
+ 
+ @since 1.1.0
+ */
+- (void) beginRelayoutOfView:(nonnull UIView *) view;
+
+/**
+ Looks up a pooled constraint of `view` matching the given structure. A match
+ is removed from the pool and gets `constant` and `priority`. An inactive match
+ is activated by `endRelayoutOfView:`.
+ 
+ @return The reused constraint or `nil` if a new constraint has to be created.
+ 
+ @since 1.1.0
+ */
+- (nullable NSLayoutConstraint *) reuseConstraintOfView:(nonnull UIView *) view
+                                              attribute:(ALKAttribute) attribute
+                                              relatedBy:(ALKRelation) relation
+                                                 toItem:(nullable id) relatedItem
+                                              attribute:(ALKAttribute) relatedAttribute
+                                             multiplier:(CGFloat) multiplier
+                                               constant:(CGFloat) constant
+                                               priority:(UILayoutPriority) priority;
+
+/**
+ Adds a constraint that has been created during the relayout of `view`. An
+ inactive constraint is activated by `endRelayoutOfView:`.
+ 
+ @since 1.1.0
+ */
+- (void) addConstraint:(nonnull NSLayoutConstraint *) constraint ofView:(nonnull UIView *) view;
+
+/**
+ Deactivates the pooled constraints of `view` that have not been reused and
+ keeps them as spares. Then activates the reused and added constraints in a
+ single batch.
+ 
+ @since 1.1.0
+ */
+- (void) endRelayoutOfView:(nonnull UIView *) view;
+
+@end
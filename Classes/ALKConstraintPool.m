@@ -0,0 +1,263 @@
+//  ALKConstraintPool.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <malloc/malloc.h>
+#import <objc/runtime.h>
+
+#import "ALKConstraintPool.h"
+#import "ALKLayoutRecorder.h"
+
+/// The constraints owned by a single view.
+@interface ALKViewConstraintPool : NSObject
+
+/// Constraints created or reused by the last relayout, all of them active.
+@property (nonatomic, strong, nonnull) NSMutableArray<NSLayoutConstraint *> * constraints;
+/// Constraints that can be reused by the running relayout, `nil` outside of relayouts.
+@property (nonatomic, strong, nullable) NSMutableArray<NSLayoutConstraint *> * candidates;
+/// Inactive constraints of the running relayout, activated once the leftovers are deactivated.
+@property (nonatomic, strong, nonnull) NSMutableArray<NSLayoutConstraint *> * activations;
+/// Inactive constraints of earlier relayouts.
+@property (nonatomic, strong, nonnull) NSMutableArray<NSLayoutConstraint *> * spares;
+
+@end
+
+@implementation ALKViewConstraintPool
+
+- (nonnull instancetype) init {
+    self = [super init];
+    if (self) {
+        self.constraints = [NSMutableArray array];
+        self.spares = [NSMutableArray array];
+        self.activations = [NSMutableArray array];
+    }
+    return self;
+}
+
+@end
+
+@interface ALKConstraintPool ()
+
+/// All view pools, each one is owned by its view and goes away with it.
+@property (nonatomic, strong, nonnull) NSHashTable<ALKViewConstraintPool *> * pools;
+@property (nonatomic, assign, readwrite) NSUInteger hitCount;
+@property (nonatomic, assign, readwrite) NSUInteger missCount;
+
+@end
+
+@implementation ALKConstraintPool
+
++ (nonnull instancetype) sharedPool {
+    static ALKConstraintPool * sharedPool = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedPool = [[ALKConstraintPool alloc] init];
+    });
+    return sharedPool;
+}
+
+- (nonnull instancetype) init {
+    self = [super init];
+    if (self) {
+        self.pools = [NSHashTable weakObjectsHashTable];
+        self.maximumSpareCount = 32;
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(purge)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void) dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark - Statistics
+
+- (double) hitRate {
+    NSUInteger total = self.hitCount + self.missCount;
+    return (total > 0) ? (double)self.hitCount / (double)total : 0.0;
+}
+
+- (NSUInteger) spareCount {
+    NSUInteger count = 0;
+    for (ALKViewConstraintPool *pool in self.pools) {
+        count += pool.spares.count;
+    }
+    return count;
+}
+
+- (NSUInteger) constraintCount {
+    NSUInteger count = 0;
+    for (ALKViewConstraintPool *pool in self.pools) {
+        count += pool.constraints.count;
+    }
+    return count;
+}
+
+- (size_t) memoryFootprint {
+    size_t bytes = malloc_size((__bridge const void *)self.pools);
+    for (ALKViewConstraintPool *pool in self.pools) {
+        bytes += poolFootprint(pool);
+    }
+    return bytes;
+}
+
+- (size_t) memoryFootprintOfView:(nonnull UIView *) view {
+    ALKViewConstraintPool *pool = [self poolOfView:view];
+    return pool ? poolFootprint(pool) : 0;
+}
+
+- (void) resetStatistics {
+    self.hitCount = 0;
+    self.missCount = 0;
+}
+
+- (void) purge {
+    for (ALKViewConstraintPool *pool in self.pools) {
+        [pool.spares removeAllObjects];
+    }
+}
+
+#pragma mark - View Pools
+
+- (nullable ALKViewConstraintPool *) poolOfView:(nonnull UIView *) view {
+    // keyed by the receiver, so views relaid out through several pools keep one per pool
+    return objc_getAssociatedObject(view, (__bridge const void *)(self));
+}
+
+#pragma mark - Relayout Sessions
+
+- (void) beginRelayoutOfView:(nonnull UIView *) view {
+    ALKViewConstraintPool *pool = [self poolOfView:view];
+    if (nil == pool) {
+        // the view keeps its pool alive, so its spares are released with it
+        pool = [[ALKViewConstraintPool alloc] init];
+        objc_setAssociatedObject(view, (__bridge const void *)(self), pool, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        [self.pools addObject:pool];
+    }
+    
+    // active constraints first, a relayout usually declares the same relations again
+    pool.candidates = pool.constraints;
+    [pool.candidates addObjectsFromArray:pool.spares];
+    pool.constraints = [NSMutableArray arrayWithCapacity:pool.candidates.count];
+    [pool.spares removeAllObjects];
+}
+
+- (nullable NSLayoutConstraint *) reuseConstraintOfView:(nonnull UIView *) view
+                                              attribute:(ALKAttribute) attribute
+                                              relatedBy:(ALKRelation) relation
+                                                 toItem:(nullable id) relatedItem
+                                              attribute:(ALKAttribute) relatedAttribute
+                                             multiplier:(CGFloat) multiplier
+                                               constant:(CGFloat) constant
+                                               priority:(UILayoutPriority) priority {
+    ALKViewConstraintPool *pool = [self poolOfView:view];
+    
+    NSUInteger index = 0;
+    for (NSLayoutConstraint *lc in pool.candidates) {
+        if (constraintMatches(lc, view, attribute, relation, relatedItem, relatedAttribute, multiplier, priority)) {
+            [pool.candidates removeObjectAtIndex:index];
+            
+            if (lc.constant != constant || lc.priority != priority) {
+                lc.constant = constant;
+                lc.priority = priority;
+                [[ALKLayoutRecorder activeRecorder] recordValuesOfConstraint:lc];
+            }
+            
+            [pool.constraints addObject:lc];
+            if (!lc.active) {
+                [pool.activations addObject:lc];
+            }
+            self.hitCount += 1;
+            return lc;
+        }
+        index++;
+    }
+    
+    self.missCount += 1;
+    return nil;
+}
+
+- (void) addConstraint:(nonnull NSLayoutConstraint *) constraint ofView:(nonnull UIView *) view {
+    ALKViewConstraintPool *pool = [self poolOfView:view];
+    [pool.constraints addObject:constraint];
+    if (!constraint.active) {
+        [pool.activations addObject:constraint];
+    }
+}
+
+- (void) endRelayoutOfView:(nonnull UIView *) view {
+    ALKViewConstraintPool *pool = [self poolOfView:view];
+    if (nil == pool.candidates) return;
+    
+    NSMutableArray *leftovers = pool.candidates;
+    pool.candidates = nil;
+    
+    // deactivate first, so the new relations never meet the ones they replace
+    ALKLayoutRecorder *recorder = [ALKLayoutRecorder activeRecorder];
+    [NSLayoutConstraint deactivateConstraints:leftovers];
+    [recorder recordDeactivationOfConstraints:leftovers];
+    [NSLayoutConstraint activateConstraints:pool.activations];
+    [recorder recordActivationOfConstraints:pool.activations];
+    [pool.activations removeAllObjects];
+    
+    NSUInteger spareCount = MIN(leftovers.count, self.maximumSpareCount);
+    [pool.spares addObjectsFromArray:[leftovers subarrayWithRange:NSMakeRange(0, spareCount)]];
+}
+
+#pragma mark - Functions
+
+static size_t poolFootprint(ALKViewConstraintPool * _Nonnull pool) {
+    size_t bytes = malloc_size((__bridge const void *)pool);
+    bytes += malloc_size((__bridge const void *)pool.constraints) + pool.constraints.count * sizeof(void *);
+    bytes += malloc_size((__bridge const void *)pool.spares) + pool.spares.count * sizeof(void *);
+    
+    // constraints in use are installed on views and measured there
+    for (NSLayoutConstraint *lc in pool.spares) {
+        bytes += malloc_size((__bridge const void *)lc);
+    }
+    return bytes;
+}
+
+static BOOL constraintMatches(NSLayoutConstraint * _Nonnull lc,
+                              UIView * _Nonnull item,
+                              ALKAttribute attribute,
+                              ALKRelation relation,
+                              id _Nullable relatedItem,
+                              ALKAttribute relatedAttribute,
+                              CGFloat multiplier,
+                              UILayoutPriority priority) {
+    if (lc.firstItem != item || lc.secondItem != relatedItem) return NO;
+    if (lc.firstAttribute != (NSLayoutAttribute)attribute || lc.secondAttribute != (NSLayoutAttribute)relatedAttribute) return NO;
+    if (lc.relation != (NSLayoutRelation)relation || lc.multiplier != multiplier) return NO;
+    
+    // an active constraint cannot switch between required and optional
+    if (lc.active && ((lc.priority == UILayoutPriorityRequired) != (priority == UILayoutPriorityRequired))) return NO;
+    
+    return YES;
+}
+
+@end
@@ -0,0 +1,139 @@
+//  ALKConstraintRegistry.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+#import <AutoLayoutKit/ALKConstraints.h>
+
+/**
+ The `ALKConstraintRegistry` canonicalizes the relations declared by layout
+ blocks that called `-[ALKConstraints shareConstraints]`. Before such a block
+ creates a new `NSLayoutConstraint`, the registry is asked for an *active*
+ constraint with exactly the same items, attributes, relation, multiplier,
+ constant and priority. If there is one, it is returned instead and its
+ reference count is increased, so declaring the same relation twice (e.g.
+ calling `alignAllEdgesTo:` from a parent and a child setup path) only adds a
+ single constraint to the layout engine.
+ 
+ A shared constraint is given up with `releaseConstraint:`, which deactivates
+ it once no owner is left. Deactivating it directly would remove it from the
+ layout of every other owner as well.
+ 
+ Constraints of blocks that do not share are neither looked up nor registered,
+ so changing or deactivating them never affects another declaration. Named
+ constraints are left out for the same reason: their constant or activation
+ can be changed through their name.
+ 
+ The registry only holds weak references to constraints.
+ 
+ The registry is not thread-safe and must only be used from the main thread,
+ like the rest of UIKit.
+ 
+ @since 1.1.0
+ */
+@interface ALKConstraintRegistry : NSObject
+
+/**
+ The registry that is used by `ALKConstraints`.
+ 
+ @since 1.1.0
+ */
++ (nonnull instancetype) sharedRegistry;
+
+/**
+ Looks up an active constraint matching all of the given fields.
+ 
+ @return The matching constraint or `nil` if the relation has not been declared
+ yet (or its constraint has been deactivated or changed in the meantime).
+ 
+ @since 1.1.0
+ */
+- (nullable NSLayoutConstraint *) constraintWithItem:(nonnull id) item
+                                           attribute:(ALKAttribute) attribute
+                                           relatedBy:(ALKRelation) relation
+                                              toItem:(nullable id) relatedItem
+                                           attribute:(ALKAttribute) relatedAttribute
+                                          multiplier:(CGFloat) multiplier
+                                            constant:(CGFloat) constant
+                                            priority:(UILayoutPriority) priority;
+
+/**
+ Remembers `constraint` under the relation described by its current fields so
+ that later declarations of the same relation can share it.
+ 
+ @since 1.1.0
+ */
+- (void) registerConstraint:(nonnull NSLayoutConstraint *) constraint;
+
+/**
+ Increases the reference count of a shared constraint. Every constraint starts
+ with a reference count of `1` once it has been created.
+ 
+ @return The new reference count.
+ 
+ @since 1.1.0
+ */
+- (NSUInteger) retainConstraint:(nonnull NSLayoutConstraint *) constraint;
+
+/**
+ Decreases the reference count of a shared constraint and deactivates it
+ once the count reaches `0`.
+ 
+ @return The remaining reference count.
+ 
+ @since 1.1.0
+ */
+- (NSUInteger) releaseConstraint:(nonnull NSLayoutConstraint *) constraint;
+
+/**
+ The number of declarations that have been merged into an already existing
+ constraint. A growing number points to setup code that declares the same
+ relation more than once and should be cleaned up.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger mergedConstraintCount;
+
+/**
+ Resets `mergedConstraintCount` to `0`.
+ 
+ @since 1.1.0
+ */
+- (void) resetMergedConstraintCount;
+
+/**
+ The number of registered constraints that are still alive.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger constraintCount;
+
+/**
+ The number of bytes held by the lookup table, not counting the constraints.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) size_t memoryFootprint;
+
+@end
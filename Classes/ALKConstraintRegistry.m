@@ -0,0 +1,292 @@
+//  ALKConstraintRegistry.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <malloc/malloc.h>
+#import <objc/runtime.h>
+
+#import "ALKConstraintRegistry.h"
+#import "ALKLayoutRecorder.h"
+
+NSString * const kALKConstraintReferenceCount = @"kALKConstraintReferenceCount";
+
+/// All fields that make two declared relations identical. The struct is always
+/// zeroed before it is filled so that padding does not influence the hash.
+typedef struct {
+    const void * item;
+    NSInteger attribute;
+    NSInteger relation;
+    const void * relatedItem;
+    NSInteger relatedAttribute;
+    CGFloat multiplier;
+    CGFloat constant;
+    float priority;
+} ALKConstraintKey;
+
+/// Initial number of slots, always a power of two.
+static NSUInteger const kALKRegistryInitialCapacity = 64;
+
+@interface ALKConstraintRegistry ()
+
+@property (nonatomic, assign, readwrite) NSUInteger mergedConstraintCount;
+
+@end
+
+@implementation ALKConstraintRegistry {
+    // Open addressing table stored as parallel arrays. Probing only scans the
+    // contiguous hash and item arrays; a constraint is only touched once both
+    // match. A hash of 0 marks an empty slot.
+    uint64_t * _hashes;
+    const void ** _items;
+    NSPointerArray * _constraints;
+    NSUInteger _capacity;
+    NSUInteger _used;
+}
+
++ (nonnull instancetype) sharedRegistry {
+    static ALKConstraintRegistry * sharedRegistry = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedRegistry = [[ALKConstraintRegistry alloc] init];
+    });
+    return sharedRegistry;
+}
+
+- (nonnull instancetype) init {
+    self = [super init];
+    if (self) {
+        [self allocateSlots:kALKRegistryInitialCapacity];
+    }
+    return self;
+}
+
+- (void) dealloc {
+    free(_hashes);
+    free(_items);
+}
+
+#pragma mark - Public API
+
+- (nullable NSLayoutConstraint *) constraintWithItem:(nonnull id) item
+                                           attribute:(ALKAttribute) attribute
+                                           relatedBy:(ALKRelation) relation
+                                              toItem:(nullable id) relatedItem
+                                           attribute:(ALKAttribute) relatedAttribute
+                                          multiplier:(CGFloat) multiplier
+                                            constant:(CGFloat) constant
+                                            priority:(UILayoutPriority) priority {
+    ALKConstraintKey key = constraintKey(item, attribute, relation, relatedItem, relatedAttribute, multiplier, constant, priority);
+    uint64_t hash = hashConstraintKey(&key);
+    
+    NSUInteger mask = _capacity - 1;
+    for (NSUInteger slot = (NSUInteger)hash & mask; _hashes[slot] != 0; slot = (slot + 1) & mask) {
+        if (_hashes[slot] != hash || _items[slot] != key.item) continue;
+        
+        // the hash only narrows the search down, the fields have to match exactly
+        NSLayoutConstraint * lc = (__bridge NSLayoutConstraint *)[_constraints pointerAtIndex:slot];
+        if (nil == lc || !lc.active || !constraintMatchesKey(lc, &key)) continue;
+        
+        self.mergedConstraintCount += 1;
+        return lc;
+    }
+    
+    return nil;
+}
+
+- (void) registerConstraint:(nonnull NSLayoutConstraint *) constraint {
+    ALKConstraintKey key = constraintKey(constraint.firstItem,
+                                         (ALKAttribute)constraint.firstAttribute,
+                                         (ALKRelation)constraint.relation,
+                                         constraint.secondItem,
+                                         (ALKAttribute)constraint.secondAttribute,
+                                         constraint.multiplier,
+                                         constraint.constant,
+                                         constraint.priority);
+    uint64_t hash = hashConstraintKey(&key);
+    
+    // replace the entry of the same relation or reuse the first dead slot on the probe path
+    NSUInteger mask = _capacity - 1;
+    NSUInteger target = NSNotFound;
+    NSUInteger slot = (NSUInteger)hash & mask;
+    for (; _hashes[slot] != 0; slot = (slot + 1) & mask) {
+        if (_hashes[slot] == hash && _items[slot] == key.item) {
+            target = slot;
+            break;
+        }
+        if (target == NSNotFound && NULL == [_constraints pointerAtIndex:slot]) {
+            target = slot;
+        }
+    }
+    
+    if (target == NSNotFound) {
+        target = slot;
+        _used += 1;
+    }
+    
+    _hashes[target] = hash;
+    _items[target] = key.item;
+    [_constraints replacePointerAtIndex:target withPointer:(__bridge void *)constraint];
+    
+    // keep probe paths short
+    if (_used * 2 > _capacity) {
+        [self rehash];
+    }
+}
+
+- (NSUInteger) retainConstraint:(nonnull NSLayoutConstraint *) constraint {
+    NSUInteger count = referenceCount(constraint) + 1;
+    setReferenceCount(constraint, count);
+    return count;
+}
+
+- (NSUInteger) releaseConstraint:(nonnull NSLayoutConstraint *) constraint {
+    NSUInteger count = referenceCount(constraint);
+    count = (count > 0) ? (count - 1) : 0;
+    setReferenceCount(constraint, count);
+    
+    // the last owner is gone, the constraint leaves the layout of everyone
+    if (0 == count && constraint.active) {
+        constraint.active = NO;
+        [[ALKLayoutRecorder activeRecorder] recordDeactivationOfConstraints:@[ constraint ]];
+    }
+    return count;
+}
+
+- (void) resetMergedConstraintCount {
+    self.mergedConstraintCount = 0;
+}
+
+- (NSUInteger) constraintCount {
+    NSUInteger count = 0;
+    for (NSUInteger i = 0; i < _capacity; i++) {
+        if (_hashes[i] != 0 && [_constraints pointerAtIndex:i]) count++;
+    }
+    return count;
+}
+
+- (size_t) memoryFootprint {
+    return malloc_size(_hashes) + malloc_size(_items) + malloc_size((__bridge const void *)_constraints) + _capacity * sizeof(void *);
+}
+
+#pragma mark - Storage
+
+- (void) allocateSlots:(NSUInteger) capacity {
+    _capacity = capacity;
+    _used = 0;
+    _hashes = calloc(capacity, sizeof(uint64_t));
+    _items = calloc(capacity, sizeof(const void *));
+    _constraints = [NSPointerArray weakObjectsPointerArray];
+    _constraints.count = capacity;
+}
+
+- (void) rehash {
+    uint64_t * hashes = _hashes;
+    const void ** items = _items;
+    NSPointerArray * constraints = _constraints;
+    NSUInteger capacity = _capacity;
+    
+    NSUInteger live = 0;
+    for (NSUInteger i = 0; i < capacity; i++) {
+        if (hashes[i] != 0 && [constraints pointerAtIndex:i]) live++;
+    }
+    
+    // dead entries are dropped, so the table only grows if most entries are alive
+    NSUInteger newCapacity = kALKRegistryInitialCapacity;
+    while (newCapacity < live * 4) newCapacity *= 2;
+    [self allocateSlots:newCapacity];
+    
+    NSUInteger mask = newCapacity - 1;
+    for (NSUInteger i = 0; i < capacity; i++) {
+        void * constraint = [constraints pointerAtIndex:i];
+        if (hashes[i] == 0 || NULL == constraint) continue;
+        
+        NSUInteger slot = (NSUInteger)hashes[i] & mask;
+        while (_hashes[slot] != 0) slot = (slot + 1) & mask;
+        
+        _hashes[slot] = hashes[i];
+        _items[slot] = items[i];
+        [_constraints replacePointerAtIndex:slot withPointer:constraint];
+        _used += 1;
+    }
+    
+    free(hashes);
+    free(items);
+}
+
+#pragma mark - Functions
+
+static ALKConstraintKey constraintKey(id _Nullable item,
+                                      ALKAttribute attribute,
+                                      ALKRelation relation,
+                                      id _Nullable relatedItem,
+                                      ALKAttribute relatedAttribute,
+                                      CGFloat multiplier,
+                                      CGFloat constant,
+                                      UILayoutPriority priority) {
+    ALKConstraintKey key;
+    memset(&key, 0, sizeof(key));
+    key.item = (__bridge const void *)item;
+    key.attribute = attribute;
+    key.relation = relation;
+    key.relatedItem = (__bridge const void *)relatedItem;
+    key.relatedAttribute = relatedAttribute;
+    // adding 0 turns -0.f into 0.f so both hash identically
+    key.multiplier = multiplier + 0.f;
+    key.constant = constant + 0.f;
+    key.priority = priority + 0.f;
+    return key;
+}
+
+static uint64_t hashConstraintKey(const ALKConstraintKey * _Nonnull key) {
+    // FNV-1a over the raw bytes of the key
+    const unsigned char * bytes = (const unsigned char *)key;
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < sizeof(ALKConstraintKey); i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    // 0 marks an empty slot
+    return hash ? hash : 1;
+}
+
+static BOOL constraintMatchesKey(NSLayoutConstraint * _Nonnull constraint, const ALKConstraintKey * _Nonnull key) {
+    return (__bridge const void *)constraint.firstItem == key->item
+        && constraint.firstAttribute == key->attribute
+        && constraint.relation == key->relation
+        && (__bridge const void *)constraint.secondItem == key->relatedItem
+        && constraint.secondAttribute == key->relatedAttribute
+        && constraint.multiplier == key->multiplier
+        && constraint.constant == key->constant
+        && constraint.priority == key->priority;
+}
+
+static NSUInteger referenceCount(NSLayoutConstraint * _Nonnull constraint) {
+    NSNumber * count = objc_getAssociatedObject(constraint, (__bridge const void *)(kALKConstraintReferenceCount));
+    return count ? count.unsignedIntegerValue : 1;
+}
+
+static void setReferenceCount(NSLayoutConstraint * _Nonnull constraint, NSUInteger count) {
+    objc_setAssociatedObject(constraint, (__bridge const void *)(kALKConstraintReferenceCount), @(count), OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
+@end
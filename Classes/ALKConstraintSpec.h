@@ -0,0 +1,99 @@
+//  ALKConstraintSpec.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+/**
+ This type only exists to wrap the `NSLayoutAttribute` enum which uses rather
+ long names that are a hassle to type. Basically, these are just shorter names
+ meaning exactly the same.
+ 
+ @since 0.1.0
+ */
+typedef NS_ENUM(NSInteger, ALKAttribute) {
+  /** NSLayoutAttributeLeft */            ALKLeft = NSLayoutAttributeLeft,
+  /** NSLayoutAttributeRight */           ALKRight = NSLayoutAttributeRight,
+  /** NSLayoutAttributeTop */             ALKTop = NSLayoutAttributeTop,
+  /** NSLayoutAttributeBottom */          ALKBottom = NSLayoutAttributeBottom,
+  /** NSLayoutAttributeLeading */         ALKLeading = NSLayoutAttributeLeading,
+  /** NSLayoutAttributeTrailing */        ALKTrailing = NSLayoutAttributeTrailing,
+  /** NSLayoutAttributeWidth */           ALKWidth = NSLayoutAttributeWidth,
+  /** NSLayoutAttributeHeight */          ALKHeight = NSLayoutAttributeHeight,
+  /** NSLayoutAttributeCenterX */         ALKCenterX = NSLayoutAttributeCenterX,
+  /** NSLayoutAttributeCenterY */         ALKCenterY = NSLayoutAttributeCenterY,
+  /** NSLayoutAttributeBaseline */        ALKBaseline = NSLayoutAttributeBaseline,
+  /** NSLayoutAttributeNotAnAttribute */  ALKNone = NSLayoutAttributeNotAnAttribute
+};
+
+/**
+ This type only exists to wrap the `NSLayoutRelation` enum which uses rather
+ long names that are a hassle to type. Basically, these are just shorter names
+ meaning exactly the same.
+ 
+ @since 0.1.0
+ */
+typedef NS_ENUM(NSInteger, ALKRelation) {
+  /** NSLayoutRelationLessThanOrEqual */    ALKLessThan = NSLayoutRelationLessThanOrEqual,
+  /** NSLayoutRelationEqual */              ALKEqualTo = NSLayoutRelationEqual,
+  /** NSLayoutRelationGreaterThanOrEqual */ ALKGreaterThan = NSLayoutRelationGreaterThanOrEqual
+};
+
+/**
+ Used as `relatedItem` of an `ALKConstraintSpec` that does not relate to
+ another view, e.g. a fixed width.
+ 
+ @since 1.1.0
+ */
+static const uint8_t ALKSpecNoItem = UINT8_MAX;
+
+/**
+ @brief A plain description of a single constraint.
+ 
+ Views are referenced by their index in the `items` array that is passed to
+ `+apply:count:items:`, so a table of specs does not depend on any instance
+ and can be a static constant. `ALKLayoutDSL.h` builds such tables at compile
+ time from C++ expressions.
+ 
+ @since 1.1.0
+ */
+typedef struct {
+  /** Index of the constrained view. */
+  uint8_t item;
+  /** Attribute of the constrained view. */
+  ALKAttribute attribute;
+  /** Relation between both sides. */
+  ALKRelation relation;
+  /** Index of the related view or `ALKSpecNoItem`. */
+  uint8_t relatedItem;
+  /** Attribute of the related view, `ALKNone` without a related view. */
+  ALKAttribute relatedAttribute;
+  /** Multiplier of the related attribute. */
+  CGFloat multiplier;
+  /** Constant of the constraint. */
+  CGFloat constant;
+  /** Priority of the constraint. */
+  UILayoutPriority priority;
+  /** Optional name, see `alk_addConstraint:withName:`. */
+  const char * _Nullable name;
+} ALKConstraintSpec;
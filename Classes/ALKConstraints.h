@@ -24,42 +24,10 @@
 
 #import <UIKit/UIKit.h>
 
-@class ALKConstraints;
+#import <AutoLayoutKit/ALKConstraintSpec.h>
+#import <AutoLayoutKit/ALKPreparedConstraints.h>
 
-/**
- This type only exists to wrap the `NSLayoutAttribute` enum which uses rather
- long names that are a hassle to type. Basically, these are just shorter names
- meaning exactly the same.
- 
- @since 0.1.0
- */
-typedef NS_ENUM(NSInteger, ALKAttribute) {
-  /** NSLayoutAttributeLeft */            ALKLeft = NSLayoutAttributeLeft,
-  /** NSLayoutAttributeRight */           ALKRight = NSLayoutAttributeRight,
-  /** NSLayoutAttributeTop */             ALKTop = NSLayoutAttributeTop,
-  /** NSLayoutAttributeBottom */          ALKBottom = NSLayoutAttributeBottom,
-  /** NSLayoutAttributeLeading */         ALKLeading = NSLayoutAttributeLeading,
-  /** NSLayoutAttributeTrailing */        ALKTrailing = NSLayoutAttributeTrailing,
-  /** NSLayoutAttributeWidth */           ALKWidth = NSLayoutAttributeWidth,
-  /** NSLayoutAttributeHeight */          ALKHeight = NSLayoutAttributeHeight,
-  /** NSLayoutAttributeCenterX */         ALKCenterX = NSLayoutAttributeCenterX,
-  /** NSLayoutAttributeCenterY */         ALKCenterY = NSLayoutAttributeCenterY,
-  /** NSLayoutAttributeBaseline */        ALKBaseline = NSLayoutAttributeBaseline,
-  /** NSLayoutAttributeNotAnAttribute */  ALKNone = NSLayoutAttributeNotAnAttribute
-};
-
-/**
- This type only exists to wrap the `NSLayoutRelation` enum which uses rather
- long names that are a hassle to type. Basically, these are just shorter names
- meaning exactly the same.
- 
- @since 0.1.0
- */
-typedef NS_ENUM(NSInteger, ALKRelation) {
-  /** NSLayoutRelationLessThanOrEqual */    ALKLessThan = NSLayoutRelationLessThanOrEqual,
-  /** NSLayoutRelationEqual */              ALKEqualTo = NSLayoutRelationEqual,
-  /** NSLayoutRelationGreaterThanOrEqual */ ALKGreaterThan = NSLayoutRelationGreaterThanOrEqual
-};
+@class ALKConstraints;
 
 /**
  @brief This is a special block type that is used by the DSL to create sets of
@@ -142,6 +110,218 @@ typedef void (^LKLayoutBlock)(ALKConstraints * _Nonnull c);
  */
 - (nonnull instancetype) initWithView:(nonnull UIView *) view;
 
+/**
+ @brief Works like `+layout:do:` but recycles the constraints of the previous
+ relayout of `view`.
+ 
+ Use this to configure reusable cells. Constraints declared with `set:` and
+ `make:` are taken from the `ALKConstraintPool` of `view` if a constraint with
+ the same structure exists; only its constant and priority are rewritten.
+ Constraints of the previous relayout that are not declared again are
+ deactivated. The declared constraints are activated together when
+ `layoutBlock` returns, after the stale ones have been deactivated.
+ 
+    [ALKConstraints relayout:cell.contentView do:^(ALKConstraints *c) {
+      [c set:ALKHeight to:item.height];
+    }];
+ 
+ Named constraints and constraints related to safe areas are not pooled and
+ behave exactly like in `+layout:do:`.
+ 
+ @param view The view that will be the target of all `NSLayoutConstraint`
+ instances created in `layoutBlock`
+ @param layoutBlock The block wherein the created `ALKConstraints` instance
+ lives.
+ 
+ @see ALKConstraintPool
+ 
+ @since 1.1.0
+ */
++ (nonnull ALKConstraints *) relayout:(nonnull UIView *) view do:(nonnull LKLayoutBlock) layoutBlock;
+
+/**
+ @brief Declares a constraint set that is applied later on the main thread.
+ 
+ Works like `+layout:do:` but can be called from any thread. Nothing in the
+ view hierarchy is touched while `layoutBlock` runs: the declared relations are
+ only recorded by the returned `ALKPreparedConstraints`, which is not shared
+ with any other thread. Call `-[ALKPreparedConstraints commit]` on the main
+ thread to apply them in one go.
+ 
+    ALKPreparedConstraints *prepared = [ALKConstraints prepare:self.someView do:^(ALKPreparedConstraints *c) {
+      [c set:ALKHeight to:60.f];
+      [c make:ALKTop equalTo:self.someOtherView s:ALKBottom];
+    }];
+ 
+    dispatch_async(dispatch_get_main_queue(), ^{
+      [prepared commit];
+    });
+ 
+ `NSLayoutConstraint` must only be used on the main thread, so no constraint
+ exists before the commit and the declaring methods of
+ `ALKPreparedConstraints` return nothing. The commit creates the constraints
+ and returns them in the order they have been declared.
+ 
+ @param view The view that will be the target of all `NSLayoutConstraint`
+ instances declared in `layoutBlock`
+ @param layoutBlock The block wherein the created `ALKPreparedConstraints`
+ instance lives.
+ 
+ @see ALKPreparedConstraints
+ 
+ @since 1.1.0
+ */
++ (nonnull ALKPreparedConstraints *) prepare:(nonnull UIView *) view do:(nonnull LKPrepareBlock) layoutBlock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Constraint Tables
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ @brief Creates the constraints described by a table of specs.
+ 
+ Each spec is declared as if it was passed to `set:` or `make:` in a
+ `+layout:do:` block of its `item`, so named constraints are registered on the
+ superview of the item. They are
+ registered on the item itself if it relates to no other view or if it has
+ no superview.
+ 
+    static const ALKConstraintSpec kHeaderLayout[] = {
+      { 1, ALKLeft, ALKEqualTo, 0, ALKLeft, 1.f, 10.f, UILayoutPriorityRequired, NULL },
+      { 1, ALKWidth, ALKEqualTo, ALKSpecNoItem, ALKNone, 1.f, 100.f, UILayoutPriorityRequired, "width" },
+    };
+    [ALKConstraints apply:kHeaderLayout count:2 items:@[self, self.titleLabel]];
+ 
+ @param specs The table of specs.
+ @param count The number of specs in `specs`.
+ @param items The views referenced by the specs.
+ 
+ @return The created constraints in the order of `specs`.
+ 
+ @since 1.1.0
+ */
++ (nonnull NSArray<NSLayoutConstraint *> *) apply:(nonnull const ALKConstraintSpec *) specs
+                                             count:(NSUInteger) count
+                                             items:(nonnull NSArray<UIView *> *) items;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Layout Variants
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ @brief Declares the constraints of `variantBlock` for the layout variant
+ `tag` of `view` instead of activating them.
+ 
+ The constraints are created once and activated whenever `tag` becomes the
+ current variant of `view`.
+ 
+    [c variant:@"editing" on:self do:^(ALKConstraints *c) {
+      [c make:ALKBottom equalTo:self s:ALKBottom minus:216.f name:@"bottom"];
+    }];
+    
+    [[ALKLayoutVariants variantsOfView:self] switchToVariant:@"editing"];
+ 
+ The block gets the receiver, so its priority and target view apply. Variants
+ cannot be nested.
+ 
+ @param tag The tag of the variant.
+ @param view The view that stores the variant, usually the common superview
+ of all views it constrains.
+ @param variantBlock The block that declares the constraints of the variant.
+ 
+ @see ALKLayoutVariants
+ 
+ @since 1.1.0
+ */
+- (void) variant:(nonnull NSString *) tag on:(nonnull UIView *) view do:(nonnull LKLayoutBlock) variantBlock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Constant Resolution
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ @brief Snaps the constants of all upcoming constraints to a fixed grid.
+ 
+ With a resolution of `n`, every constant is rounded to the nearest multiple of
+ `1/n` point before its constraint is created, so constants that have been
+ computed in a different order (e.g. `0.1 + 0.2` and `0.3`) become bit-identical.
+ Such constraints can be shared by `ALKConstraintRegistry`, produce the same frames
+ and the same keys in layout caches. Constants changed with
+ `alk_setConstant:forConstraintWithName:` and `alk_setConstants:` are snapped
+ as well.
+ 
+ Use `64` for a fixed-point grid that is finer than any screen, or the scale of
+ the screen to snap constants to whole pixels:
+ 
+    [ALKConstraints setConstantResolution:(NSUInteger)[UIScreen mainScreen].scale];
+ 
+ @param resolution Steps per point or `0` to use constants as given (default).
+ 
+ @since 1.1.0
+ */
++ (void) setConstantResolution:(NSUInteger) resolution;
+
+/**
+ The current constant resolution, see `setConstantResolution:`.
+ 
+ @since 1.1.0
+ */
++ (NSUInteger) constantResolution;
+
+/**
+ Rounds `constant` to the current constant resolution.
+ 
+ @param constant A constant in points.
+ 
+ @return The snapped constant or `constant` if snapping is off.
+ 
+ @since 1.1.0
+ */
++ (CGFloat) snappedConstant:(CGFloat) constant;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Anchors
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ The number of layout anchors that have been resolved through UIKit.
+ 
+ Anchors used by the `equalToSafeArea:` methods are kept per view and per safe
+ area layout guide for the lifetime of the view, so rebuilding a layout (e.g.
+ on a size class change) does not resolve them again.
+ 
+ @since 1.1.0
+ */
++ (NSUInteger) resolvedAnchorCount;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Sharing Constraints
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ @brief Shares all upcoming unnamed constraints of the receiver with identical
+ active constraints declared by other sharing blocks.
+ 
+ By default, every declaration gets a constraint of its own. After this call,
+ `ALKConstraintRegistry` is asked for an identical constraint first, so setup
+ paths that declare the same relation twice only add it to the layout engine
+ once:
+ 
+    [ALKConstraints layout:self.contentView do:^(ALKConstraints *c) {
+      [c shareConstraints];
+      [c alignAllEdgesTo:self];
+    }];
+ 
+ A shared constraint belongs to every block that declared it. Give it up with
+ `-[ALKConstraintRegistry releaseConstraint:]` instead of deactivating it, the
+ last owner to release it deactivates it. Named constraints are never shared.
+ 
+ @see ALKConstraintRegistry
+ 
+ @since 1.1.0
+ */
+- (void) shareConstraints;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @name Configuring the ALKConstrain Priorities
 ////////////////////////////////////////////////////////////////////////////////
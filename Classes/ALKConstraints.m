@@ -22,7 +22,13 @@
 //  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 //  THE SOFTWARE.
 
+#import <objc/runtime.h>
+
 #import "ALKConstraints.h"
+#import "ALKConstraintPool.h"
+#import "ALKConstraintRegistry.h"
+#import "ALKLayoutRecorder.h"
+#import "ALKLayoutVariants.h"
 #import "UIView+ALKNamedConstraints.h"
 
 @interface ALKConstraints ()
@@ -30,29 +36,186 @@
 @property (nonatomic, strong, nonnull) UIView * item;
 @property (nonatomic, assign) UILayoutPriority priority;
 
+/// `YES` while the block of `+relayout:do:` runs
+@property (nonatomic, assign) BOOL pooled;
+
+/// `YES` once `-shareConstraints` has been called
+@property (nonatomic, assign) BOOL sharing;
+
+/// the variants and the tag that constraints are added to while a `-variant:on:do:` block runs
+@property (nonatomic, strong, nullable) ALKLayoutVariants * variants;
+@property (nonatomic, copy, nullable) NSString * variantTag;
+
+- (nonnull UIView *) defaultTargetView;
+- (nonnull UIView *) targetViewForRelatedItem:(nullable id) relatedItem;
+- (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute
+                      equalToSafeArea:(nullable id) relatedItem
+                                    s:(ALKAttribute) relatedAttribute
+                                 plus:(CGFloat) constant
+                             priority:(UILayoutPriority) priority
+                                 name:(nullable NSString *) name;
+
+#if defined(NSFoundationVersionNumber_iOS_9_0)
+- (nullable id) itemAnchor:(ALKAttribute) attribute;
+- (nullable id) safeAreaAnchorOf:(nonnull UIView *) view attribute:(ALKAttribute) attribute;
+#endif
+
 @end
 
+/// Number of anchor slots. Slots are indexed by `ALKAttribute` which maps
+/// directly onto the small `NSLayoutAttribute` values (`ALKNone` ... `ALKBaseline`).
+enum { ALKAnchorSlotCount = ALKBaseline + 1 };
+
+/// The anchors of a view and of its safe area layout guide, resolved at most
+/// once per slot for the lifetime of the view.
+@interface ALKAnchorTable : NSObject {
+    @public
+    __strong id _anchors[ALKAnchorSlotCount];
+    __strong id _safeAreaAnchors[ALKAnchorSlotCount];
+}
+@end
+
+@implementation ALKAnchorTable
+@end
+
+NSString * const kALKAnchorTable = @"kALKAnchorTable";
+
+/// steps per point constants are rounded to, 0 if they are used as given
+static NSUInteger ALKConstantResolution = 0;
+
+/// number of anchors resolved through UIKit, see `+resolvedAnchorCount`
+static NSUInteger ALKResolvedAnchorCount = 0;
+
 @implementation ALKConstraints
 
 + (nonnull ALKConstraints *) layout:(nonnull UIView *) view do:(nonnull LKLayoutBlock) layoutBlock {
+    [[ALKLayoutRecorder activeRecorder] recordLayoutOfView:view];
+    
     ALKConstraints *c = [[ALKConstraints alloc] initWithView:view];
     layoutBlock(c);
     
     return c;
 }
 
++ (nonnull ALKConstraints *) relayout:(nonnull UIView *) view do:(nonnull LKLayoutBlock) layoutBlock {
+    [[ALKLayoutRecorder activeRecorder] recordLayoutOfView:view];
+    
+    ALKConstraintPool *pool = [ALKConstraintPool sharedPool];
+    ALKConstraints *c = [[ALKConstraints alloc] initWithView:view];
+    
+    [pool beginRelayoutOfView:view];
+    c.pooled = YES;
+    layoutBlock(c);
+    c.pooled = NO;
+    [pool endRelayoutOfView:view];
+    
+    return c;
+}
+
++ (nonnull ALKPreparedConstraints *) prepare:(nonnull UIView *) view do:(nonnull LKPrepareBlock) layoutBlock {
+    ALKPreparedConstraints *prepared = [[ALKPreparedConstraints alloc] initWithView:view];
+    layoutBlock(prepared);
+    
+    return prepared;
+}
+
 - (nonnull instancetype) initWithView:(nonnull UIView *) view {
     self = [super init];
     if (self) {
         self.item = view;
         view.translatesAutoresizingMaskIntoConstraints = NO;
         
-        self.priority = UILayoutPriorityRequired;
+        _priority = UILayoutPriorityRequired;
     }
     
     return self;
 }
 
+#pragma mark - CONSTRAINT TABLES
+
++ (nonnull NSArray<NSLayoutConstraint *> *) apply:(nonnull const ALKConstraintSpec *) specs
+                                             count:(NSUInteger) count
+                                             items:(nonnull NSArray<UIView *> *) items {
+    NSMutableArray<NSLayoutConstraint *> *constraints = [NSMutableArray arrayWithCapacity:count];
+    
+    // one builder per constrained item, created when the item is used first
+    NSMutableArray *builders = [NSMutableArray arrayWithCapacity:items.count];
+    for (NSUInteger i = 0; i < items.count; i++) {
+        [builders addObject:[NSNull null]];
+    }
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        const ALKConstraintSpec *spec = &specs[i];
+        NSAssert(spec->item < items.count, @"ALKConstraintSpec item %u is out of range", spec->item);
+        NSAssert(spec->relatedItem == ALKSpecNoItem || spec->relatedItem < items.count, @"ALKConstraintSpec related item %u is out of range", spec->relatedItem);
+        
+        ALKConstraints *builder = builders[spec->item];
+        if ((id)builder == [NSNull null]) {
+            builder = [ALKConstraints layout:items[spec->item] do:^(ALKConstraints *c) {}];
+            builders[spec->item] = builder;
+        }
+        
+        id relatedItem = (spec->relatedItem == ALKSpecNoItem) ? nil : items[spec->relatedItem];
+        UIView *targetItem = [builder targetViewForRelatedItem:relatedItem];
+        NSString *name = spec->name ? @(spec->name) : nil;
+        
+        [constraints addObject:make(builder, spec->attribute, spec->relation, relatedItem, spec->relatedAttribute, spec->multiplier, spec->constant, targetItem, name, spec->priority)];
+    }
+    
+    return constraints;
+}
+
+#pragma mark - RESOLUTION
+
++ (void) setConstantResolution:(NSUInteger) resolution {
+    ALKConstantResolution = resolution;
+}
+
++ (NSUInteger) constantResolution {
+    return ALKConstantResolution;
+}
+
++ (CGFloat) snappedConstant:(CGFloat) constant {
+    return snapConstant(constant);
+}
+
+#pragma mark - VARIANTS
+
+- (void) variant:(nonnull NSString *) tag on:(nonnull UIView *) view do:(nonnull LKLayoutBlock) variantBlock {
+    NSAssert(nil == self.variants, @"Layout variants cannot be nested");
+    
+    self.variants = [ALKLayoutVariants variantsOfView:view];
+    self.variantTag = tag;
+    variantBlock(self);
+    self.variants = nil;
+    self.variantTag = nil;
+}
+
+#pragma mark - ANCHORS
+
++ (NSUInteger) resolvedAnchorCount {
+    return ALKResolvedAnchorCount;
+}
+
+#pragma mark - TARGET
+
+- (nonnull UIView *) defaultTargetView {
+    // a view without a superview holds its named constraints itself
+    return self.item.superview ?: self.item;
+}
+
+- (nonnull UIView *) targetViewForRelatedItem:(nullable id) relatedItem {
+    // constraints of the item alone or relating the item to itself stay on the item
+    if (nil == relatedItem || relatedItem == self.item) return self.item;
+    return self.defaultTargetView;
+}
+
+#pragma mark - SHARING
+
+- (void) shareConstraints {
+    self.sharing = YES;
+}
+
 #pragma mark - PRIORITY
 
 - (void) setPriorityRequired {
@@ -74,29 +237,29 @@
 #pragma mark - DSL (SET)
 
 - (nonnull NSLayoutConstraint *) set:(ALKAttribute) attribute to:(CGFloat) constant {
-    return set(self.item, attribute, constant, nil, self.priority);
+    return set(self, attribute, constant, nil, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) set:(ALKAttribute) attribute to:(CGFloat) constant name:(nullable NSString *) name {
-    return set(self.item, attribute, constant, name, self.priority);
+    return set(self, attribute, constant, name, self.priority);
 }
 
 #pragma mark - DSL (MAKE)
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nonnull UIView *) targetView {
-    return make(self.item, attribute, ALKEqualTo, relatedItem, relatedAttribute, multiplier, constant, targetView, nil, self.priority);
+    return make(self, attribute, ALKEqualTo, relatedItem, relatedAttribute, multiplier, constant, targetView, nil, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier minus:(CGFloat) constant on:(nonnull UIView *) targetView {
-    return make(self.item, attribute, ALKEqualTo, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, nil, self.priority);
+    return make(self, attribute, ALKEqualTo, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, nil, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nonnull UIView *) targetView name:(nullable NSString *) name {
-    return make(self.item, attribute, ALKEqualTo, relatedItem, relatedAttribute, multiplier, constant, targetView, name, self.priority);
+    return make(self, attribute, ALKEqualTo, relatedItem, relatedAttribute, multiplier, constant, targetView, name, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier minus:(CGFloat) constant on:(nonnull UIView *) targetView name:(nullable NSString *) name {
-    return make(self.item, attribute, ALKEqualTo, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, name, self.priority);
+    return make(self, attribute, ALKEqualTo, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, name, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant on:(nonnull UIView *) targetView {
@@ -181,7 +344,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier minus:(CGFloat) constant {
@@ -190,7 +353,7 @@
                     s:relatedAttribute
                 times:multiplier
                 minus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant name:(nullable NSString *) name {
@@ -199,7 +362,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -209,7 +372,7 @@
                     s:relatedAttribute
                 times:multiplier
                 minus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -219,7 +382,7 @@
                     s:relatedAttribute
                 times:1.f
                  plus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute minus:(CGFloat) constant {
@@ -228,7 +391,7 @@
                     s:relatedAttribute
                 times:1.f
                 minus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant name:(nullable NSString *) name {
@@ -237,7 +400,7 @@
                     s:relatedAttribute
                 times:1.f
                  plus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -247,7 +410,7 @@
                     s:relatedAttribute
                 times:1.f
                 minus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -257,7 +420,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:0.f
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier name:(nullable NSString *) name {
@@ -266,7 +429,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:0.f
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -276,7 +439,7 @@
                     s:relatedAttribute
                 times:1.f
                  plus:0.f
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute name:(nullable NSString *) name {
@@ -285,26 +448,26 @@
                     s:relatedAttribute
                 times:1.f
                  plus:0.f
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
 #pragma mark - DSL (MAKE/LESSTHAN)
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nonnull UIView *) targetView {
-    return make(self.item, attribute, ALKLessThan, relatedItem, relatedAttribute, multiplier, constant, targetView, nil, self.priority);
+    return make(self, attribute, ALKLessThan, relatedItem, relatedAttribute, multiplier, constant, targetView, nil, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier minus:(CGFloat) constant on:(nonnull UIView *) targetView {
-    return make(self.item, attribute, ALKLessThan, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, nil, self.priority);
+    return make(self, attribute, ALKLessThan, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, nil, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nonnull UIView *) targetView name:(nullable NSString *) name {
-    return make(self.item, attribute, ALKLessThan, relatedItem, relatedAttribute, multiplier, constant, targetView, name, self.priority);
+    return make(self, attribute, ALKLessThan, relatedItem, relatedAttribute, multiplier, constant, targetView, name, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier minus:(CGFloat) constant on:(nonnull UIView *) targetView name:(nullable NSString *) name {
-    return make(self.item, attribute, ALKLessThan, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, name, self.priority);
+    return make(self, attribute, ALKLessThan, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, name, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant on:(nonnull UIView *) targetView {
@@ -389,7 +552,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier minus:(CGFloat) constant {
@@ -398,7 +561,7 @@
                     s:relatedAttribute
                 times:multiplier
                 minus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant name:(nullable NSString *) name {
@@ -407,7 +570,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -417,7 +580,7 @@
                     s:relatedAttribute
                 times:multiplier
                 minus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -427,7 +590,7 @@
                     s:relatedAttribute
                 times:1.f
                  plus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute minus:(CGFloat) constant {
@@ -436,7 +599,7 @@
                     s:relatedAttribute
                 times:1.f
                 minus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant name:(nullable NSString *) name {
@@ -445,7 +608,7 @@
                     s:relatedAttribute
                 times:1.f
                  plus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -455,7 +618,7 @@
                     s:relatedAttribute
                 times:1.f
                 minus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -465,7 +628,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:0.f
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier name:(nullable NSString *) name {
@@ -474,7 +637,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:0.f
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -484,7 +647,7 @@
                     s:relatedAttribute
                 times:1.f
                  plus:0.f
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute name:(nullable NSString *) name {
@@ -493,26 +656,26 @@
                     s:relatedAttribute
                 times:1.f
                  plus:0.f
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
 #pragma mark - DSL (MAKE/GREATERTHAN)
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nonnull UIView *) targetView {
-    return make(self.item, attribute, ALKGreaterThan, relatedItem, relatedAttribute, multiplier, constant, targetView, nil, self.priority);
+    return make(self, attribute, ALKGreaterThan, relatedItem, relatedAttribute, multiplier, constant, targetView, nil, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier minus:(CGFloat) constant on:(nonnull UIView *) targetView {
-    return make(self.item, attribute, ALKGreaterThan, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, nil, self.priority);
+    return make(self, attribute, ALKGreaterThan, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, nil, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nonnull UIView *) targetView name:(nullable NSString *) name {
-    return make(self.item, attribute, ALKGreaterThan, relatedItem, relatedAttribute, multiplier, constant, targetView, name, self.priority);
+    return make(self, attribute, ALKGreaterThan, relatedItem, relatedAttribute, multiplier, constant, targetView, name, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier minus:(CGFloat) constant on:(nonnull UIView *) targetView name:(nullable NSString *) name {
-    return make(self.item, attribute, ALKGreaterThan, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, name, self.priority);
+    return make(self, attribute, ALKGreaterThan, relatedItem, relatedAttribute, multiplier, ((-1) * constant), targetView, name, self.priority);
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant on:(nonnull UIView *) targetView {
@@ -597,7 +760,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier minus:(CGFloat) constant {
@@ -606,7 +769,7 @@
                     s:relatedAttribute
                 times:multiplier
                 minus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant name:(nullable NSString *) name {
@@ -615,7 +778,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -625,7 +788,7 @@
                     s:relatedAttribute
                 times:multiplier
                 minus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -635,7 +798,7 @@
                     s:relatedAttribute
                 times:1.f
                  plus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute minus:(CGFloat) constant {
@@ -644,7 +807,7 @@
                     s:relatedAttribute
                 times:1.f
                 minus:constant
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant name:(nullable NSString *) name {
@@ -653,7 +816,7 @@
                     s:relatedAttribute
                 times:1.f
                  plus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -663,7 +826,7 @@
                     s:relatedAttribute
                 times:1.f
                 minus:constant
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -673,7 +836,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:0.f
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier name:(nullable NSString *) name {
@@ -682,7 +845,7 @@
                     s:relatedAttribute
                 times:multiplier
                  plus:0.f
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -692,7 +855,7 @@
                     s:relatedAttribute
                 times:1.f
                  plus:0.f
-                   on:self.item.superview];
+                   on:self.defaultTargetView];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute name:(nullable NSString *) name {
@@ -701,7 +864,7 @@
                     s:relatedAttribute
                 times:1.f
                  plus:0.f
-                   on:self.item.superview
+                   on:self.defaultTargetView
                  name:name];
 }
 
@@ -710,22 +873,14 @@
                                     s:(ALKAttribute) relatedAttribute
                                  plus:(CGFloat) constant
                                  name:(nullable NSString *) name {
-    NSLayoutConstraint * lc = nil;
-#if defined(NSFoundationVersionNumber_iOS_9_0)
-    lc = makeSafeArea(self.item, attribute, relatedItem, relatedAttribute, constant, self.item.superview, name, self.priority);
-#endif
-    return lc ? lc : [self make:attribute equalTo:relatedItem s:relatedAttribute times:1 plus:constant name:name];
+    return [self make:attribute equalToSafeArea:relatedItem s:relatedAttribute plus:constant priority:self.priority name:name];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute
                       equalToSafeArea:(nullable id) relatedItem
                                     s:(ALKAttribute) relatedAttribute
                                  plus:(CGFloat) constant {
-    NSLayoutConstraint * lc = nil;
-#if defined(NSFoundationVersionNumber_iOS_9_0)
-    lc = makeSafeArea(self.item, attribute, relatedItem, relatedAttribute, constant, self.item.superview, nil, self.priority);
-#endif
-    return lc ? lc : [self make:attribute equalTo:relatedItem s:relatedAttribute times:1 plus:constant name:nil];
+    return [self make:attribute equalToSafeArea:relatedItem s:relatedAttribute plus:constant priority:self.priority name:nil];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute
@@ -733,50 +888,81 @@
                                     s:(ALKAttribute) relatedAttribute
                                 minus:(CGFloat) constant
                                  name:(nullable NSString *) name {
-    NSLayoutConstraint * lc = nil;
-#if defined(NSFoundationVersionNumber_iOS_9_0)
-    lc = makeSafeArea(self.item, attribute, relatedItem, relatedAttribute, -constant, self.item.superview, name, self.priority);
-#endif
-    return lc ? lc : [self make:attribute equalTo:relatedItem s:relatedAttribute times:1 minus:constant name:name];
+    return [self make:attribute equalToSafeArea:relatedItem s:relatedAttribute plus:-constant priority:self.priority name:name];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute
                       equalToSafeArea:(nullable id) relatedItem
                                     s:(ALKAttribute) relatedAttribute
                                 minus:(CGFloat) constant {
-    NSLayoutConstraint * lc = nil;
-#if defined(NSFoundationVersionNumber_iOS_9_0)
-    lc = makeSafeArea(self.item, attribute, relatedItem, relatedAttribute, -constant, self.item.superview, nil, self.priority);
-#endif
-    return lc ? lc : [self make:attribute equalTo:relatedItem s:relatedAttribute times:1 minus:constant name:nil];
+    return [self make:attribute equalToSafeArea:relatedItem s:relatedAttribute plus:-constant priority:self.priority name:nil];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute
                       equalToSafeArea:(nullable id) relatedItem
                                     s:(ALKAttribute) relatedAttribute
                                  name:(nullable NSString *) name {
-    NSLayoutConstraint * lc = nil;
-#if defined(NSFoundationVersionNumber_iOS_9_0)
-    lc = makeSafeArea(self.item, attribute, relatedItem, relatedAttribute, 0, self.item.superview, name, self.priority);
-#endif
-    return lc ? lc : [self make:attribute equalTo:relatedItem s:relatedAttribute times:1 plus:0 name:name];
+    return [self make:attribute equalToSafeArea:relatedItem s:relatedAttribute plus:0 priority:self.priority name:name];
 }
 
 - (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute
                       equalToSafeArea:(nullable id) relatedItem
                                     s:(ALKAttribute) relatedAttribute {
+    return [self make:attribute equalToSafeArea:relatedItem s:relatedAttribute plus:0 priority:self.priority name:nil];
+}
+
+- (nonnull NSLayoutConstraint *) make:(ALKAttribute) attribute
+                      equalToSafeArea:(nullable id) relatedItem
+                                    s:(ALKAttribute) relatedAttribute
+                                 plus:(CGFloat) constant
+                             priority:(UILayoutPriority) priority
+                                 name:(nullable NSString *) name {
+    constant = snapConstant(constant);
+    
+    if (self.variants) {
+        id safeArea = relatedItem;
+#if defined(NSFoundationVersionNumber_iOS_9_0)
+        if (@available(iOS 11, *)) {
+            safeArea = relatedItem ? ((UIView *)relatedItem).safeAreaLayoutGuide : nil;
+        }
+#endif
+        NSLayoutConstraint *lc = [NSLayoutConstraint constraintWithItem:self.item
+                                                              attribute:(NSLayoutAttribute)attribute
+                                                              relatedBy:NSLayoutRelationEqual
+                                                                 toItem:safeArea
+                                                              attribute:(NSLayoutAttribute)relatedAttribute
+                                                             multiplier:1.f
+                                                               constant:constant];
+        lc.priority = priority;
+        return [self.variants addConstraint:lc toVariant:self.variantTag targetView:self.defaultTargetView name:name];
+    }
+    
     NSLayoutConstraint * lc = nil;
 #if defined(NSFoundationVersionNumber_iOS_9_0)
-    lc = makeSafeArea(self.item, attribute, relatedItem, relatedAttribute, 0, self.item.superview, nil, self.priority);
+    lc = makeSafeArea(self, attribute, relatedItem, relatedAttribute, constant, self.defaultTargetView, name, priority);
 #endif
-    return lc ? lc : [self make:attribute equalTo:relatedItem s:relatedAttribute times:1 plus:0 name:nil];
+    return lc ? lc : createLayoutConstraint(self.item, attribute, ALKEqualTo, relatedItem, relatedAttribute, 1.f, constant, self.defaultTargetView, name, priority, self.sharing);
 }
 
+#pragma mark - Anchors
+
+#if defined(NSFoundationVersionNumber_iOS_9_0)
+
+- (nullable id) itemAnchor:(ALKAttribute) attribute {
+    return cachedAnchor(self.item, attribute, NO);
+}
+
+- (nullable id) safeAreaAnchorOf:(nonnull UIView *) view attribute:(ALKAttribute) attribute {
+    return cachedAnchor(view, attribute, YES);
+}
+
+#endif
+
 #pragma mark - Functions
 
 #if defined(NSFoundationVersionNumber_iOS_9_0)
 
-static NSLayoutConstraint * _Nullable makeSafeArea(UIView * _Nonnull item,
+static NSLayoutConstraint * _Nullable makeSafeArea(ALKConstraints * _Nonnull constraints,
                                                    ALKAttribute itemAttribute,
                                                    id _Nullable relatedItem,
                                                    ALKAttribute relatedItemAttribute,
@@ -786,57 +972,63 @@ static NSLayoutConstraint * _Nullable makeSafeArea(UIView * _Nonnull item,
                                                    UILayoutPriority priority) {
     NSLayoutConstraint * lc = nil;
     if (@available(iOS 11, *)) {
-        NSLayoutAnchor * anchor = viewLayoutAnchor(item, itemAttribute);
-        NSLayoutAnchor * relatedAnchor = relatedItem ? guideLayoutAnchor(((UIView *)relatedItem).safeAreaLayoutGuide, relatedItemAttribute) : nil;
+        if (relatedItem) {
+            lc = constraints.sharing ? sharedLayoutConstraint(constraints.item, itemAttribute, ALKEqualTo, ((UIView *)relatedItem).safeAreaLayoutGuide, relatedItemAttribute, 1.f, constant, targetItem, name, priority) : nil;
+            if (lc) return lc;
+        }
+        
+        NSLayoutAnchor * anchor = [constraints itemAnchor:itemAttribute];
+        NSLayoutAnchor * relatedAnchor = relatedItem ? [constraints safeAreaAnchorOf:(UIView *)relatedItem attribute:relatedItemAttribute] : nil;
         lc = (anchor && relatedAnchor) ? [anchor constraintEqualToAnchor:relatedAnchor] : nil;
         if (lc) {
             lc.constant = constant;
             lc.priority = priority;
-            if (name) {
-                [targetItem alk_addConstraint:lc withName:name];
-            } else {
-                lc.active = YES;
-            }
+            activateLayoutConstraint(lc, targetItem, name, constraints.sharing);
         }
     }
     return lc;
 }
 
-static id _Nullable viewLayoutAnchor(UIView * _Nonnull view, ALKAttribute attribute) {
-    if (@available(iOS 9, *)) {
-        switch (attribute) {
-            case ALKLeft: return view.leftAnchor;
-            case ALKRight: return view.rightAnchor;
-            case ALKTop: return view.topAnchor;
-            case ALKBottom: return view.bottomAnchor;
-            case ALKLeading: return view.leadingAnchor;
-            case ALKTrailing: return view.trailingAnchor;
-            case ALKWidth: return view.widthAnchor;
-            case ALKHeight: return view.heightAnchor;
-            case ALKCenterX: return view.centerXAnchor;
-            case ALKCenterY: return view.centerYAnchor;
-            case ALKBaseline: return view.firstBaselineAnchor;
-            case ALKNone: return nil;
+static id _Nullable cachedAnchor(UIView * _Nonnull view, ALKAttribute attribute, BOOL safeArea) {
+    if (attribute < 0 || attribute >= ALKAnchorSlotCount) return nil;
+    
+    // the table lives as long as the view, so rebuilt layouts reuse its anchors
+    ALKAnchorTable *table = objc_getAssociatedObject(view, (__bridge const void *)(kALKAnchorTable));
+    if (nil == table) {
+        table = [[ALKAnchorTable alloc] init];
+        objc_setAssociatedObject(view, (__bridge const void *)(kALKAnchorTable), table, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    
+    __strong id *slots = safeArea ? table->_safeAreaAnchors : table->_anchors;
+    if (nil == slots[attribute]) {
+        id viewOrGuide = view;
+        if (safeArea) {
+            if (@available(iOS 11, *)) {
+                viewOrGuide = view.safeAreaLayoutGuide;
+            } else {
+                return nil;
+            }
         }
+        slots[attribute] = layoutAnchor(viewOrGuide, attribute);
+        ALKResolvedAnchorCount += 1;
     }
-    return nil;
+    return slots[attribute];
 }
 
-static id _Nullable guideLayoutAnchor(id _Nonnull guide, ALKAttribute attribute) {
+static id _Nullable layoutAnchor(id _Nonnull viewOrGuide, ALKAttribute attribute) {
     if (@available(iOS 9, *)) {
-        UILayoutGuide * layoutGuide = (UILayoutGuide *)guide;
         switch (attribute) {
-            case ALKLeft: return layoutGuide.leftAnchor;
-            case ALKRight: return layoutGuide.rightAnchor;
-            case ALKTop: return layoutGuide.topAnchor;
-            case ALKBottom: return layoutGuide.bottomAnchor;
-            case ALKLeading: return layoutGuide.leadingAnchor;
-            case ALKTrailing: return layoutGuide.trailingAnchor;
-            case ALKWidth: return layoutGuide.widthAnchor;
-            case ALKHeight: return layoutGuide.heightAnchor;
-            case ALKCenterX: return layoutGuide.centerXAnchor;
-            case ALKCenterY: return layoutGuide.centerYAnchor;
-            case ALKBaseline:
+            case ALKLeft: return [viewOrGuide leftAnchor];
+            case ALKRight: return [viewOrGuide rightAnchor];
+            case ALKTop: return [viewOrGuide topAnchor];
+            case ALKBottom: return [viewOrGuide bottomAnchor];
+            case ALKLeading: return [viewOrGuide leadingAnchor];
+            case ALKTrailing: return [viewOrGuide trailingAnchor];
+            case ALKWidth: return [viewOrGuide widthAnchor];
+            case ALKHeight: return [viewOrGuide heightAnchor];
+            case ALKCenterX: return [viewOrGuide centerXAnchor];
+            case ALKCenterY: return [viewOrGuide centerYAnchor];
+            case ALKBaseline: return [viewOrGuide isKindOfClass:[UIView class]] ? [(UIView *)viewOrGuide firstBaselineAnchor] : nil;
             case ALKNone: return nil;
         }
     }
@@ -845,25 +1037,53 @@ static id _Nullable guideLayoutAnchor(id _Nonnull guide, ALKAttribute attribute)
 
 #endif
 
-static NSLayoutConstraint * _Nonnull set(UIView * _Nonnull item,
-                                         ALKAttribute itemAttribute,
-                                         CGFloat constant,
-                                         NSString * _Nullable name,
-                                         UILayoutPriority priority) {
-    return createLayoutConstraint(item, itemAttribute, ALKEqualTo, nil, ALKNone, 1.f, constant, item, name, priority);
+static CGFloat snapConstant(CGFloat constant) {
+    NSUInteger resolution = ALKConstantResolution;
+    if (0 == resolution) return constant;
+    
+    // computed in double on every architecture, so the result does not depend on CGFloat
+    double steps = (double)resolution;
+    return (CGFloat)(round((double)constant * steps) / steps);
 }
 
-static NSLayoutConstraint * _Nonnull make(UIView * _Nonnull item,
+static NSLayoutConstraint * _Nonnull set(ALKConstraints * _Nonnull constraints,
                                           ALKAttribute itemAttribute,
-                                          ALKRelation relation,
-                                          id _Nullable relatedItem,
-                                          ALKAttribute relatedItemAttribute,
-                                          CGFloat multiplier,
                                           CGFloat constant,
-                                          UIView * _Nonnull targetItem,
                                           NSString * _Nullable name,
                                           UILayoutPriority priority) {
-    return createLayoutConstraint(item, itemAttribute, relation, relatedItem, relatedItemAttribute, multiplier, constant, targetItem, name, priority);
+    return make(constraints, itemAttribute, ALKEqualTo, nil, ALKNone, 1.f, constant, constraints.item, name, priority);
+}
+
+static NSLayoutConstraint * _Nonnull make(ALKConstraints * _Nonnull constraints,
+                                           ALKAttribute itemAttribute,
+                                           ALKRelation relation,
+                                           id _Nullable relatedItem,
+                                           ALKAttribute relatedItemAttribute,
+                                           CGFloat multiplier,
+                                           CGFloat constant,
+                                           UIView * _Nonnull targetItem,
+                                           NSString * _Nullable name,
+                                           UILayoutPriority priority) {
+    constant = snapConstant(constant);
+    
+    if (constraints.variants) {
+        // variant constraints stay inactive until their variant becomes current
+        NSLayoutConstraint *lc = [NSLayoutConstraint constraintWithItem:constraints.item
+                                                              attribute:(NSLayoutAttribute)itemAttribute
+                                                              relatedBy:(NSLayoutRelation)relation
+                                                                 toItem:relatedItem
+                                                              attribute:(NSLayoutAttribute)relatedItemAttribute
+                                                             multiplier:multiplier
+                                                               constant:constant];
+        lc.priority = priority;
+        return [constraints.variants addConstraint:lc toVariant:constraints.variantTag targetView:targetItem name:name];
+    }
+    
+    if (constraints.pooled && nil == name) {
+        return pooledLayoutConstraint(constraints.item, itemAttribute, relation, relatedItem, relatedItemAttribute, multiplier, constant, priority);
+    }
+    
+    return createLayoutConstraint(constraints.item, itemAttribute, relation, relatedItem, relatedItemAttribute, multiplier, constant, targetItem, name, priority, constraints.sharing);
 }
 
 static NSLayoutConstraint * _Nonnull createLayoutConstraint(UIView * _Nonnull item,
@@ -875,25 +1095,106 @@ static NSLayoutConstraint * _Nonnull createLayoutConstraint(UIView * _Nonnull it
                                                             CGFloat constant,
                                                             UIView * _Nonnull targetItem,
                                                             NSString * _Nullable name,
-                                                            UILayoutPriority priority) {
+                                                            UILayoutPriority priority,
+                                                            BOOL shared) {
     
-    NSLayoutConstraint *lc = [NSLayoutConstraint constraintWithItem:item
-                                                          attribute:(NSLayoutAttribute)itemAttribute
-                                                          relatedBy:(NSLayoutRelation)relation
-                                                             toItem:relatedItem
-                                                          attribute:(NSLayoutAttribute)relatedItemAttribute
-                                                         multiplier:multiplier
-                                                           constant:constant];
+    NSLayoutConstraint *lc = shared ? sharedLayoutConstraint(item, itemAttribute, relation, relatedItem, relatedItemAttribute, multiplier, constant, targetItem, name, priority) : nil;
+    if (lc) return lc;
+    
+    lc = [NSLayoutConstraint constraintWithItem:item
+                                      attribute:(NSLayoutAttribute)itemAttribute
+                                      relatedBy:(NSLayoutRelation)relation
+                                         toItem:relatedItem
+                                      attribute:(NSLayoutAttribute)relatedItemAttribute
+                                     multiplier:multiplier
+                                       constant:constant];
     
     lc.priority = priority;
     
+    activateLayoutConstraint(lc, targetItem, name, shared);
+    
+    return lc;
+}
+
+static NSLayoutConstraint * _Nonnull pooledLayoutConstraint(UIView * _Nonnull item,
+                                                            ALKAttribute itemAttribute,
+                                                            ALKRelation relation,
+                                                            id _Nullable relatedItem,
+                                                            ALKAttribute relatedItemAttribute,
+                                                            CGFloat multiplier,
+                                                            CGFloat constant,
+                                                            UILayoutPriority priority) {
+    ALKConstraintPool *pool = [ALKConstraintPool sharedPool];
+    NSLayoutConstraint *lc = [pool reuseConstraintOfView:item
+                                               attribute:itemAttribute
+                                               relatedBy:relation
+                                                  toItem:relatedItem
+                                               attribute:relatedItemAttribute
+                                              multiplier:multiplier
+                                                constant:constant
+                                                priority:priority];
+    
+    // pooled constraints are owned by their view and never shared through the registry
+    if (nil == lc) {
+        lc = [NSLayoutConstraint constraintWithItem:item
+                                          attribute:(NSLayoutAttribute)itemAttribute
+                                          relatedBy:(NSLayoutRelation)relation
+                                             toItem:relatedItem
+                                          attribute:(NSLayoutAttribute)relatedItemAttribute
+                                         multiplier:multiplier
+                                           constant:constant];
+        lc.priority = priority;
+        
+        [pool addConstraint:lc ofView:item];
+    }
+    
+    // recorded by the pool once the relayout has activated it
+    return lc;
+}
+
+static NSLayoutConstraint * _Nullable sharedLayoutConstraint(UIView * _Nonnull item,
+                                                             ALKAttribute itemAttribute,
+                                                             ALKRelation relation,
+                                                             id _Nullable relatedItem,
+                                                             ALKAttribute relatedItemAttribute,
+                                                             CGFloat multiplier,
+                                                             CGFloat constant,
+                                                             UIView * _Nonnull targetItem,
+                                                             NSString * _Nullable name,
+                                                             UILayoutPriority priority) {
+    // a named constraint can be changed through its name, so it is never shared
+    if (name) return nil;
+    
+    ALKConstraintRegistry *registry = [ALKConstraintRegistry sharedRegistry];
+    NSLayoutConstraint *lc = [registry constraintWithItem:item
+                                                attribute:itemAttribute
+                                                relatedBy:relation
+                                                   toItem:relatedItem
+                                                attribute:relatedItemAttribute
+                                               multiplier:multiplier
+                                                 constant:constant
+                                                 priority:priority];
+    
+    // the constraint is already active and recorded, it only gains an owner
+    if (lc) {
+        [registry retainConstraint:lc];
+    }
+    
+    return lc;
+}
+
+static void activateLayoutConstraint(NSLayoutConstraint * _Nonnull lc,
+                                     UIView * _Nonnull targetItem,
+                                     NSString * _Nullable name,
+                                     BOOL shared) {
     if (name) {
         [targetItem alk_addConstraint:lc withName:name];
     } else {
         lc.active = YES;
+        [[ALKLayoutRecorder activeRecorder] recordConstraint:lc];
+        // only sharing blocks find it, so nobody else ends up owning a private constraint
+        if (shared) [[ALKConstraintRegistry sharedRegistry] registerConstraint:lc];
     }
-    
-    return lc;
 }
 
 @end
@@ -0,0 +1,202 @@
+//  ALKLayoutDSL.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <AutoLayoutKit/ALKConstraintSpec.h>
+
+#ifdef __OBJC__
+#import <AutoLayoutKit/ALKConstraints.h>
+#endif
+
+/**
+ A header-only C++17 front end that turns layout expressions into a constant
+ table of `ALKConstraintSpec`s at compile time:
+ 
+    using namespace alk;
+    
+    // 0: self, 1: titleLabel, 2: iconView
+    static constexpr auto kHeaderLayout = layout(
+      left(2) == left(0) + 10,
+      centerY(2) == centerY(0),
+      size(width(2), 24),
+      left(1) == right(2) + 8,
+      named(right(1) <= right(0) - 10, "titleRight"),
+      priority(height(1) == height(0) * 0.5, 750)
+    );
+    
+    [ALKConstraints apply:kHeaderLayout.data() count:kHeaderLayout.size() items:@[self, self.titleLabel, self.iconView]];
+ 
+ Relating attributes that `NSLayoutConstraint` would reject at runtime (e.g.
+ `left(1) == top(0)`, `leading(1) == left(0)` or `top(1) == 10`) does not
+ compile. Building the table costs nothing at runtime; applying it walks the
+ static array.
+ 
+ The `UILayoutPriority` constants are not constant expressions in C++, so
+ priorities are written as plain numbers.
+ 
+ Outside of Objective-C++ the header only depends on `ALKConstraintSpec.h`,
+ which lets `Example/PortableTests` check the generated tables with a plain
+ C++ compiler.
+ 
+ @since 1.1.0
+ */
+
+#ifdef __cplusplus
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace alk {
+
+/** The axis of an attribute. Only attributes on compatible axes can be related. */
+enum class Axis { Horizontal, Directional, CenterX, Vertical, Dimension };
+
+template <Axis A, Axis B> struct compatible : std::integral_constant<bool, A == B> {};
+template <> struct compatible<Axis::CenterX, Axis::Horizontal> : std::true_type {};
+template <> struct compatible<Axis::Horizontal, Axis::CenterX> : std::true_type {};
+template <> struct compatible<Axis::CenterX, Axis::Directional> : std::true_type {};
+template <> struct compatible<Axis::Directional, Axis::CenterX> : std::true_type {};
+
+/** `UILayoutPriorityRequired` is not a constant expression in every SDK. */
+constexpr UILayoutPriority kRequired = static_cast<UILayoutPriority>(1000);
+
+/** An attribute of the view at `item` in the items array. */
+template <Axis A>
+struct Anchor {
+  uint8_t item;
+  ALKAttribute attribute;
+};
+
+/** `anchor * multiplier + constant` */
+template <Axis A>
+struct Term {
+  Anchor<A> anchor;
+  CGFloat multiplier;
+  CGFloat constant;
+};
+
+constexpr Anchor<Axis::Horizontal> left(uint8_t item) { return {item, ALKLeft}; }
+constexpr Anchor<Axis::Horizontal> right(uint8_t item) { return {item, ALKRight}; }
+constexpr Anchor<Axis::Directional> leading(uint8_t item) { return {item, ALKLeading}; }
+constexpr Anchor<Axis::Directional> trailing(uint8_t item) { return {item, ALKTrailing}; }
+constexpr Anchor<Axis::CenterX> centerX(uint8_t item) { return {item, ALKCenterX}; }
+constexpr Anchor<Axis::Vertical> top(uint8_t item) { return {item, ALKTop}; }
+constexpr Anchor<Axis::Vertical> bottom(uint8_t item) { return {item, ALKBottom}; }
+constexpr Anchor<Axis::Vertical> centerY(uint8_t item) { return {item, ALKCenterY}; }
+constexpr Anchor<Axis::Vertical> baseline(uint8_t item) { return {item, ALKBaseline}; }
+constexpr Anchor<Axis::Dimension> width(uint8_t item) { return {item, ALKWidth}; }
+constexpr Anchor<Axis::Dimension> height(uint8_t item) { return {item, ALKHeight}; }
+
+template <typename N>
+using if_number = typename std::enable_if<std::is_arithmetic<N>::value, int>::type;
+
+template <Axis A, typename N, if_number<N> = 0>
+constexpr Term<A> operator*(Anchor<A> anchor, N multiplier) { return {anchor, static_cast<CGFloat>(multiplier), 0}; }
+
+template <Axis A, typename N, if_number<N> = 0>
+constexpr Term<A> operator*(N multiplier, Anchor<A> anchor) { return {anchor, static_cast<CGFloat>(multiplier), 0}; }
+
+template <Axis A, typename N, if_number<N> = 0>
+constexpr Term<A> operator+(Anchor<A> anchor, N constant) { return {anchor, 1, static_cast<CGFloat>(constant)}; }
+
+template <Axis A, typename N, if_number<N> = 0>
+constexpr Term<A> operator-(Anchor<A> anchor, N constant) { return {anchor, 1, -static_cast<CGFloat>(constant)}; }
+
+template <Axis A, typename N, if_number<N> = 0>
+constexpr Term<A> operator+(Term<A> term, N constant) { return {term.anchor, term.multiplier, term.constant + static_cast<CGFloat>(constant)}; }
+
+template <Axis A, typename N, if_number<N> = 0>
+constexpr Term<A> operator-(Term<A> term, N constant) { return {term.anchor, term.multiplier, term.constant - static_cast<CGFloat>(constant)}; }
+
+namespace detail {
+
+template <Axis A, Axis B>
+constexpr ALKConstraintSpec relate(Anchor<A> anchor, ALKRelation relation, Term<B> term) {
+  static_assert(compatible<A, B>::value, "AutoLayoutKit: these attributes cannot be related to each other");
+  return {anchor.item, anchor.attribute, relation, term.anchor.item, term.anchor.attribute, term.multiplier, term.constant, kRequired, nullptr};
+}
+
+template <Axis A, typename N>
+constexpr ALKConstraintSpec fix(Anchor<A> anchor, ALKRelation relation, N constant) {
+  static_assert(A == Axis::Dimension, "AutoLayoutKit: only width and height can be set to a constant");
+  return {anchor.item, anchor.attribute, relation, ALKSpecNoItem, ALKNone, 1, static_cast<CGFloat>(constant), kRequired, nullptr};
+}
+
+template <Axis A>
+constexpr Term<A> term(Anchor<A> anchor) { return {anchor, 1, 0}; }
+
+} // namespace detail
+
+#define ALK_DSL_RELATION(OP, RELATION) \
+  template <Axis A, Axis B> \
+  constexpr ALKConstraintSpec operator OP(Anchor<A> anchor, Term<B> term) { return detail::relate(anchor, RELATION, term); } \
+  template <Axis A, Axis B> \
+  constexpr ALKConstraintSpec operator OP(Anchor<A> anchor, Anchor<B> related) { return detail::relate(anchor, RELATION, detail::term(related)); } \
+  template <Axis A, typename N, if_number<N> = 0> \
+  constexpr ALKConstraintSpec operator OP(Anchor<A> anchor, N constant) { return detail::fix(anchor, RELATION, constant); }
+
+ALK_DSL_RELATION(==, ALKEqualTo)
+ALK_DSL_RELATION(<=, ALKLessThan)
+ALK_DSL_RELATION(>=, ALKGreaterThan)
+
+#undef ALK_DSL_RELATION
+
+/** Returns `spec` with the given priority. */
+constexpr ALKConstraintSpec priority(ALKConstraintSpec spec, UILayoutPriority priority) {
+  spec.priority = priority;
+  return spec;
+}
+
+/** Returns `spec` with the given name. */
+constexpr ALKConstraintSpec named(ALKConstraintSpec spec, const char *name) {
+  spec.name = name;
+  return spec;
+}
+
+/** Shorthand for `dimension == constant`. */
+template <typename N, if_number<N> = 0>
+constexpr ALKConstraintSpec size(Anchor<Axis::Dimension> dimension, N constant) {
+  return dimension == constant;
+}
+
+/** Collects specs into a table that can be passed to `+apply:count:items:`. */
+template <typename... Specs>
+constexpr std::array<ALKConstraintSpec, sizeof...(Specs)> layout(Specs... specs) {
+  return {{specs...}};
+}
+
+#ifdef __OBJC__
+
+/** Applies a table created by `layout()`. */
+template <std::size_t N>
+inline NSArray<NSLayoutConstraint *> * _Nonnull apply(const std::array<ALKConstraintSpec, N> &table, NSArray<UIView *> * _Nonnull items) {
+  return [ALKConstraints apply:table.data() count:N items:items];
+}
+
+#endif
+
+} // namespace alk
+
+#endif
@@ -0,0 +1,122 @@
+//  ALKLayoutFlattener.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+/**
+ A container view found by `ALKLayoutFlattener`.
+ 
+ @since 1.1.0
+ */
+@interface ALKNestedLayout : NSObject
+
+/**
+ The container that reports its size through `intrinsicContentSize`.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, weak, readonly, nullable) UIView * container;
+
+/**
+ The number of constraints installed in the subtree of the container.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger constraintCount;
+
+/**
+ `YES` if the layout of the container has been merged into the layout of its
+ superview, `NO` if it has been left as it is because it is too large.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) BOOL merged;
+
+@end
+
+/**
+ The `ALKLayoutFlattener` merges nested container layouts into the layout of
+ the surrounding view hierarchy.
+ 
+ A container that computes its `intrinsicContentSize` from the frames of its
+ subviews can only report a size once its subviews have been laid out, and
+ every change of that size lays out its superview again. When its content
+ spans such a container on both axes, i.e. a single subview or a chain of
+ subviews is pinned from one edge to the opposite one, the content already
+ determines its size in the same layout problem. Flattening lowers the content
+ hugging and compression resistance of the container to
+ `UILayoutPriorityFittingSizeLevel`, so the pinned content decides its size in
+ one solve and the measured size only remains a fallback.
+ 
+ Merging makes every layout pass of the surrounding hierarchy include the
+ constraints of the container, so large nested layouts are kept separate. The
+ containers of UIKit itself are never changed.
+ 
+    NSArray<ALKNestedLayout *> *report = [ALKLayoutFlattener flattenView:self.view maximumConstraintCount:32];
+    ...
+    [ALKLayoutFlattener unflattenLayouts:report];
+ 
+ @since 1.1.0
+ */
+@interface ALKLayoutFlattener : NSObject
+
+/**
+ Finds the nested container layouts below `view` without changing them.
+ 
+ @param view The root of the subtree to search.
+ 
+ @return One entry per container, `merged` is always `NO`.
+ 
+ @since 1.1.0
+ */
++ (nonnull NSArray<ALKNestedLayout *> *) nestedLayoutsInView:(nonnull UIView *) view;
+
+/**
+ Merges the nested container layouts below `view` whose subtrees contain at
+ most `maximumConstraintCount` constraints.
+ 
+ @param view The root of the subtree to flatten.
+ @param maximumConstraintCount The largest nested layout that is merged.
+ 
+ @return One entry per container that has been found, merged or not.
+ 
+ @since 1.1.0
+ */
++ (nonnull NSArray<ALKNestedLayout *> *) flattenView:(nonnull UIView *) view
+                             maximumConstraintCount:(NSUInteger) maximumConstraintCount;
+
+/**
+ Restores the content hugging and compression resistance priorities the merged
+ containers of `nestedLayouts` had before they have been flattened. Entries
+ that have not been merged are skipped, all others are no longer `merged`
+ afterwards.
+ 
+ @param nestedLayouts The report returned by
+ `flattenView:maximumConstraintCount:`.
+ 
+ @since 1.1.0
+ */
++ (void) unflattenLayouts:(nonnull NSArray<ALKNestedLayout *> *) nestedLayouts;
+
+@end
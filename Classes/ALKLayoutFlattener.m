@@ -0,0 +1,221 @@
+//  ALKLayoutFlattener.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKLayoutFlattener.h"
+
+@interface ALKNestedLayout () {
+@public
+    /// the priorities of the container before it has been merged, indexed by axis
+    UILayoutPriority _huggingPriorities[2];
+    UILayoutPriority _compressionResistancePriorities[2];
+}
+
+@property (nonatomic, weak, readwrite, nullable) UIView * container;
+@property (nonatomic, assign, readwrite) NSUInteger constraintCount;
+@property (nonatomic, assign, readwrite) BOOL merged;
+
+@end
+
+/// An edge of a container along one axis.
+typedef NS_ENUM(NSInteger, ALKContainerEdge) {
+    ALKContainerEdgeNone,
+    ALKContainerEdgeStart,
+    ALKContainerEdgeEnd
+};
+
+@implementation ALKNestedLayout
+
+- (nonnull NSString *) description {
+    return [NSString stringWithFormat:@"<%@: %p; container = <%@: %p>; constraints = %lu; merged = %@>",
+            NSStringFromClass([self class]), self, NSStringFromClass([self.container class]), self.container,
+            (unsigned long)self.constraintCount, self.merged ? @"YES" : @"NO"];
+}
+
+@end
+
+@implementation ALKLayoutFlattener
+
++ (nonnull NSArray<ALKNestedLayout *> *) nestedLayoutsInView:(nonnull UIView *) view {
+    return [self flattenView:view maximumConstraintCount:0 merging:NO];
+}
+
++ (nonnull NSArray<ALKNestedLayout *> *) flattenView:(nonnull UIView *) view
+                             maximumConstraintCount:(NSUInteger) maximumConstraintCount {
+    return [self flattenView:view maximumConstraintCount:maximumConstraintCount merging:YES];
+}
+
++ (nonnull NSArray<ALKNestedLayout *> *) flattenView:(nonnull UIView *) root
+                             maximumConstraintCount:(NSUInteger) maximumConstraintCount
+                                            merging:(BOOL) merging {
+    NSMutableArray<ALKNestedLayout *> *nestedLayouts = [NSMutableArray array];
+    
+    NSMutableArray<UIView *> *stack = [root.subviews mutableCopy];
+    while (stack.count > 0) {
+        UIView *view = [stack lastObject];
+        [stack removeLastObject];
+        [stack addObjectsFromArray:view.subviews];
+        
+        if (!measuresOwnSize(view) || !isPinnedToContent(view)) continue;
+        
+        ALKNestedLayout *nestedLayout = [[ALKNestedLayout alloc] init];
+        nestedLayout.container = view;
+        nestedLayout.constraintCount = constraintCountOfSubtree(view);
+        
+        if (merging && nestedLayout.constraintCount <= maximumConstraintCount) {
+            for (NSNumber *axis in @[ @(UILayoutConstraintAxisHorizontal), @(UILayoutConstraintAxisVertical) ]) {
+                UILayoutConstraintAxis a = (UILayoutConstraintAxis)axis.integerValue;
+                nestedLayout->_huggingPriorities[a] = [view contentHuggingPriorityForAxis:a];
+                nestedLayout->_compressionResistancePriorities[a] = [view contentCompressionResistancePriorityForAxis:a];
+                [view setContentHuggingPriority:UILayoutPriorityFittingSizeLevel forAxis:a];
+                [view setContentCompressionResistancePriority:UILayoutPriorityFittingSizeLevel forAxis:a];
+            }
+            [view invalidateIntrinsicContentSize];
+            nestedLayout.merged = YES;
+        }
+        
+        [nestedLayouts addObject:nestedLayout];
+    }
+    
+    return nestedLayouts;
+}
+
++ (void) unflattenLayouts:(nonnull NSArray<ALKNestedLayout *> *) nestedLayouts {
+    // newest first, so a container flattened twice ends up with its original priorities
+    for (ALKNestedLayout *nestedLayout in [nestedLayouts reverseObjectEnumerator]) {
+        if (!nestedLayout.merged) continue;
+        nestedLayout.merged = NO;
+        
+        UIView *view = nestedLayout.container;
+        if (nil == view) continue;
+        
+        for (NSNumber *axis in @[ @(UILayoutConstraintAxisHorizontal), @(UILayoutConstraintAxisVertical) ]) {
+            UILayoutConstraintAxis a = (UILayoutConstraintAxis)axis.integerValue;
+            [view setContentHuggingPriority:nestedLayout->_huggingPriorities[a] forAxis:a];
+            [view setContentCompressionResistancePriority:nestedLayout->_compressionResistancePriorities[a] forAxis:a];
+        }
+        [view invalidateIntrinsicContentSize];
+    }
+}
+
+#pragma mark - Functions
+
+static BOOL measuresOwnSize(UIView * _Nonnull view) {
+    // the controls of UIKit measure their content themselves, only app containers are flattened
+    Class cls = [view class];
+    if ([NSBundle bundleForClass:cls] == [NSBundle bundleForClass:[UIView class]]) return NO;
+    
+    SEL selector = @selector(intrinsicContentSize);
+    return [cls instanceMethodForSelector:selector] != [UIView instanceMethodForSelector:selector];
+}
+
+static BOOL isPinnedToContent(UIView * _Nonnull container) {
+    return isSpannedByContent(container, UILayoutConstraintAxisHorizontal)
+        && isSpannedByContent(container, UILayoutConstraintAxisVertical);
+}
+
+static BOOL isSpannedByContent(UIView * _Nonnull container, UILayoutConstraintAxis axis) {
+    NSHashTable<UIView *> *startViews = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    NSHashTable<UIView *> *endViews = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    NSMapTable<UIView *, NSMutableArray<UIView *> *> *followers = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                                                                          valueOptions:NSPointerFunctionsStrongMemory];
+    
+    // constraints between a view and its subviews or among the subviews are installed on the view
+    for (NSLayoutConstraint *lc in container.constraints) {
+        if (!lc.active || lc.relation != NSLayoutRelationEqual || lc.priority < UILayoutPriorityRequired) continue;
+        
+        id first = lc.firstItem;
+        id second = lc.secondItem;
+        ALKContainerEdge firstEdge = edgeOfAttribute(lc.firstAttribute, axis);
+        ALKContainerEdge secondEdge = edgeOfAttribute(lc.secondAttribute, axis);
+        if (ALKContainerEdgeNone == firstEdge || ALKContainerEdgeNone == secondEdge) continue;
+        
+        if (first == container || second == container) {
+            // a subview pinned to an edge of the container
+            id subview = (first == container) ? second : first;
+            if (!isSubviewOf(subview, container) || firstEdge != secondEdge) continue;
+            [(ALKContainerEdgeStart == firstEdge ? startViews : endViews) addObject:subview];
+        } else if (isSubviewOf(first, container) && isSubviewOf(second, container) && firstEdge != secondEdge) {
+            // the end of one subview attached to the start of the next one
+            UIView *previous = (ALKContainerEdgeEnd == firstEdge) ? first : second;
+            UIView *next = (ALKContainerEdgeEnd == firstEdge) ? second : first;
+            NSMutableArray<UIView *> *nextViews = [followers objectForKey:previous];
+            if (nil == nextViews) {
+                nextViews = [NSMutableArray array];
+                [followers setObject:nextViews forKey:previous];
+            }
+            [nextViews addObject:next];
+        }
+    }
+    
+    // a single subview pinned to both edges or a chain from the start to the end edge
+    NSHashTable<UIView *> *visited = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    NSMutableArray<UIView *> *stack = [[startViews allObjects] mutableCopy];
+    while (stack.count > 0) {
+        UIView *view = [stack lastObject];
+        [stack removeLastObject];
+        if ([visited containsObject:view]) continue;
+        [visited addObject:view];
+        
+        if ([endViews containsObject:view]) return YES;
+        [stack addObjectsFromArray:[followers objectForKey:view] ?: @[]];
+    }
+    
+    return NO;
+}
+
+static ALKContainerEdge edgeOfAttribute(NSLayoutAttribute attribute, UILayoutConstraintAxis axis) {
+    if (UILayoutConstraintAxisHorizontal == axis) {
+        switch (attribute) {
+            case NSLayoutAttributeLeft:
+            case NSLayoutAttributeLeading:  return ALKContainerEdgeStart;
+            case NSLayoutAttributeRight:
+            case NSLayoutAttributeTrailing: return ALKContainerEdgeEnd;
+            default:                        return ALKContainerEdgeNone;
+        }
+    }
+    
+    switch (attribute) {
+        case NSLayoutAttributeTop:      return ALKContainerEdgeStart;
+        case NSLayoutAttributeBottom:   return ALKContainerEdgeEnd;
+        default:                        return ALKContainerEdgeNone;
+    }
+}
+
+static BOOL isSubviewOf(id _Nullable item, UIView * _Nonnull container) {
+    return [item isKindOfClass:[UIView class]] && [item superview] == container;
+}
+
+static NSUInteger constraintCountOfSubtree(UIView * _Nonnull root) {
+    NSUInteger count = 0;
+    NSMutableArray<UIView *> *stack = [NSMutableArray arrayWithObject:root];
+    while (stack.count > 0) {
+        UIView *view = [stack lastObject];
+        [stack removeLastObject];
+        count += view.constraints.count;
+        [stack addObjectsFromArray:view.subviews];
+    }
+    return count;
+}
+
+@end
@@ -0,0 +1,212 @@
+//  ALKLayoutPipeline.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+#import <AutoLayoutKit/ALKConstraints.h>
+
+/**
+ The `ALKLayoutPipeline` splits a layout pass into stages that can overlap
+ across consecutive frames:
+ 
+ 1. *Build*: layout blocks run on a serial worker queue through
+ `+[ALKConstraints prepare:do:]`.
+ 2. *Apply*: on the next tick the builders that are ready are committed on the
+ main thread, in the order they have been submitted.
+ 3. *Solve*: the views touched by the apply stage are laid out with
+ `layoutIfNeeded` in the same tick.
+ 
+ While frame N is applied and solved on the main thread, the blocks of frame
+ N + 1 are already building on the worker queue, so the main thread no longer
+ waits for declarations during continuous resizes.
+ 
+    ALKLayoutPipeline *pipeline = [ALKLayoutPipeline mainPipeline];
+    [pipeline layout:self.someView do:^(ALKPreparedConstraints *c) {
+      [c set:ALKHeight to:height];
+    }];
+ 
+ Pipelines created with `-initWithBuildQueue:` are not attached to the display
+ and only advance when `-tick` is called, which makes them deterministic for
+ tests. Call `-start` to drive such a pipeline with a display link.
+ 
+ Display link ticks are time-sliced: a tick stops applying builders once its
+ `frameBudget` is spent and leaves the rest for the next tick. Builders are
+ always applied as a whole, so every frame that reaches the screen satisfies
+ all required constraints of the blocks applied so far.
+ 
+ All methods except the initializers must be called on the main thread.
+ 
+ @since 1.1.0
+ */
+@interface ALKLayoutPipeline : NSObject
+
+/**
+ A shared pipeline that builds on a background queue and ticks with the
+ display.
+ 
+ @since 1.1.0
+ */
++ (nonnull ALKLayoutPipeline *) mainPipeline;
+
+/**
+ Creates a pipeline that builds on a new serial queue.
+ 
+ @since 1.1.0
+ */
+- (nonnull instancetype) init;
+
+/**
+ Creates a pipeline that builds on `buildQueue`.
+ 
+ @param buildQueue A serial queue. Suspending it stalls the build stage, which
+ is useful to simulate slow builds in tests.
+ 
+ @since 1.1.0
+ */
+- (nonnull instancetype) initWithBuildQueue:(nonnull dispatch_queue_t) buildQueue NS_DESIGNATED_INITIALIZER;
+
+/**
+ Submits a layout block to the build stage. The constraints are applied on the
+ first tick after the block has finished building.
+ 
+ The block runs on the build queue: it must not access UIKit state other than
+ passing views to the `ALKPreparedConstraints` methods.
+ 
+ @param view The view that will be the target of the created constraints.
+ @param layoutBlock The block that declares the constraints.
+ 
+ @since 1.1.0
+ */
+- (void) layout:(nonnull UIView *) view do:(nonnull LKPrepareBlock) layoutBlock;
+
+/**
+ Runs the apply and solve stages for all builders that are ready.
+ 
+ Builders are applied in submission order. If a block is still building, it
+ and all blocks submitted after it wait for the next tick.
+ 
+ @return The number of layout blocks that have been applied.
+ 
+ @since 1.1.0
+ */
+- (NSUInteger) tick;
+
+/**
+ Runs the apply and solve stages for the builders that are ready, until
+ `deadline` has passed.
+ 
+ The deadline is checked before each builder is committed, so at least one
+ ready builder is applied per tick and a slice is at most one builder plus
+ the following `layoutIfNeeded` longer than requested. Builders that did not
+ fit are applied on the next tick; the views keep their last applied layout
+ meanwhile.
+ 
+ @param deadline A time in the timebase of `clock`.
+ 
+ @return The number of layout blocks that have been applied. Check
+ `pendingCount` to find out whether the pipeline is done.
+ 
+ @since 1.1.0
+ */
+- (NSUInteger) tickWithDeadline:(CFTimeInterval) deadline;
+
+/**
+ Blocks until every submitted layout block has finished building. This is
+ meant for tests and must not be called while the build queue is suspended.
+ 
+ @since 1.1.0
+ */
+- (void) waitUntilBuilt;
+
+/**
+ Starts ticking with the display. The pipeline is retained by its display link
+ until `-stop` is called.
+ 
+ The display link is paused while no layout block is pending and resumes as
+ soon as a block is submitted, so an idle pipeline does not wake up the main
+ thread on every frame.
+ 
+ @since 1.1.0
+ */
+- (void) start;
+
+/**
+ Stops ticking with the display.
+ 
+ @since 1.1.0
+ */
+- (void) stop;
+
+/**
+ `YES` while the pipeline has been started and its display link fires, i.e.
+ while layout blocks are pending.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly, getter=isTicking) BOOL ticking;
+
+/**
+ The number of layout blocks that have been submitted but not applied yet.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger pendingCount;
+
+/**
+ The number of ticks that have applied at least one layout block.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger appliedFrameCount;
+
+/**
+ The time a display link tick may spend applying builders. Defaults to 8ms.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign) CFTimeInterval frameBudget;
+
+/**
+ The clock used for deadlines and tick durations. Defaults to
+ `CACurrentMediaTime`. Replace it to simulate time in tests.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, copy, nonnull) CFTimeInterval (^clock)(void);
+
+/**
+ The duration of the longest tick that applied at least one builder.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) CFTimeInterval longestTickDuration;
+
+/**
+ Resets `longestTickDuration` and `appliedFrameCount`.
+ 
+ @since 1.1.0
+ */
+- (void) resetStatistics;
+
+@end
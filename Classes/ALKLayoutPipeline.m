@@ -0,0 +1,206 @@
+//  ALKLayoutPipeline.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "ALKLayoutPipeline.h"
+
+@interface ALKPipelineJob : NSObject
+
+@property (nonatomic, strong, nonnull) UIView * view;
+@property (nonatomic, copy, nullable) LKPrepareBlock layoutBlock;
+/// Set on the build queue, read on the main thread while holding the pipeline lock.
+@property (nonatomic, strong, nullable) ALKPreparedConstraints * builder;
+
+@end
+
+@implementation ALKPipelineJob
+
+@end
+
+@interface ALKLayoutPipeline ()
+
+@property (nonatomic, strong, nonnull) dispatch_queue_t buildQueue;
+@property (nonatomic, strong, nonnull) NSMutableArray<ALKPipelineJob *> * jobs;
+@property (nonatomic, strong, nonnull) NSLock * lock;
+@property (nonatomic, strong, nullable) CADisplayLink * displayLink;
+@property (nonatomic, assign, readwrite) NSUInteger appliedFrameCount;
+@property (nonatomic, assign, readwrite) CFTimeInterval longestTickDuration;
+
+@end
+
+@implementation ALKLayoutPipeline
+
++ (nonnull ALKLayoutPipeline *) mainPipeline {
+    static ALKLayoutPipeline *mainPipeline = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mainPipeline = [[ALKLayoutPipeline alloc] init];
+        [mainPipeline start];
+    });
+    return mainPipeline;
+}
+
+- (nonnull instancetype) init {
+    dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0);
+    return [self initWithBuildQueue:dispatch_queue_create("org.projectserver.AutoLayoutKit.pipeline", attributes)];
+}
+
+- (nonnull instancetype) initWithBuildQueue:(nonnull dispatch_queue_t) buildQueue {
+    self = [super init];
+    if (self) {
+        self.buildQueue = buildQueue;
+        self.jobs = [NSMutableArray array];
+        self.lock = [[NSLock alloc] init];
+        self.frameBudget = 0.008;
+        self.clock = ^CFTimeInterval {
+            return CACurrentMediaTime();
+        };
+    }
+    return self;
+}
+
+- (void) dealloc {
+    [_displayLink invalidate];
+}
+
+#pragma mark - Build
+
+- (void) layout:(nonnull UIView *) view do:(nonnull LKPrepareBlock) layoutBlock {
+    NSAssert([NSThread isMainThread], @"ALKLayoutPipeline must be used on the main thread");
+    
+    ALKPipelineJob *job = [[ALKPipelineJob alloc] init];
+    job.view = view;
+    job.layoutBlock = layoutBlock;
+    
+    [self.lock lock];
+    [self.jobs addObject:job];
+    [self.lock unlock];
+    
+    // the display link idles while the queue is empty
+    self.displayLink.paused = NO;
+    
+    NSLock *lock = self.lock;
+    dispatch_async(self.buildQueue, ^{
+        ALKPreparedConstraints *builder = [ALKConstraints prepare:job.view do:job.layoutBlock];
+        
+        [lock lock];
+        job.builder = builder;
+        job.layoutBlock = nil;
+        [lock unlock];
+    });
+}
+
+- (void) waitUntilBuilt {
+    dispatch_sync(self.buildQueue, ^{});
+}
+
+#pragma mark - Apply & Solve
+
+- (NSUInteger) tick {
+    return [self tickWithDeadline:INFINITY];
+}
+
+- (NSUInteger) tickWithDeadline:(CFTimeInterval) deadline {
+    NSAssert([NSThread isMainThread], @"ALKLayoutPipeline must be used on the main thread");
+    
+    CFTimeInterval start = self.clock();
+    
+    [self.lock lock];
+    NSUInteger readyCount = 0;
+    for (ALKPipelineJob *job in self.jobs) {
+        if (!job.builder) break;
+        readyCount++;
+    }
+    NSArray<ALKPipelineJob *> *readyJobs = [self.jobs subarrayWithRange:NSMakeRange(0, readyCount)];
+    [self.lock unlock];
+    
+    if (readyCount == 0) return 0;
+    
+    // apply, builders are never split so required constraints stay satisfied
+    NSHashTable<UIView *> *rootViews = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    NSUInteger appliedCount = 0;
+    for (ALKPipelineJob *job in readyJobs) {
+        if (appliedCount > 0 && self.clock() >= deadline) break;
+        
+        [job.builder commit];
+        [rootViews addObject:(job.view.superview ?: job.view)];
+        appliedCount++;
+    }
+    
+    [self.lock lock];
+    [self.jobs removeObjectsInRange:NSMakeRange(0, appliedCount)];
+    BOOL drained = (self.jobs.count == 0);
+    [self.lock unlock];
+    
+    if (drained) {
+        self.displayLink.paused = YES;
+    }
+    
+    // solve
+    for (UIView *view in rootViews) {
+        [view layoutIfNeeded];
+    }
+    
+    self.appliedFrameCount++;
+    self.longestTickDuration = MAX(self.longestTickDuration, self.clock() - start);
+    return appliedCount;
+}
+
+- (void) resetStatistics {
+    self.appliedFrameCount = 0;
+    self.longestTickDuration = 0;
+}
+
+- (NSUInteger) pendingCount {
+    [self.lock lock];
+    NSUInteger count = self.jobs.count;
+    [self.lock unlock];
+    return count;
+}
+
+#pragma mark - Display Link
+
+- (void) start {
+    if (self.displayLink) return;
+    
+    self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(displayLinkDidFire:)];
+    self.displayLink.paused = (self.pendingCount == 0);
+    [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+- (BOOL) isTicking {
+    return self.displayLink && !self.displayLink.paused;
+}
+
+- (void) stop {
+    [self.displayLink invalidate];
+    self.displayLink = nil;
+}
+
+- (void) displayLinkDidFire:(CADisplayLink *) displayLink {
+    [self tickWithDeadline:self.clock() + self.frameBudget];
+}
+
+@end
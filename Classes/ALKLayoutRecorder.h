@@ -0,0 +1,207 @@
+//  ALKLayoutRecorder.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+#import <AutoLayoutKit/ALKConstraints.h>
+
+/**
+ The result of replaying a recorded layout session.
+ 
+ @since 1.1.0
+ */
+typedef struct {
+  /** The number of operations read from the stream. */
+  NSUInteger operations;
+  /** The number of constraints that have been declared during the replay. */
+  NSUInteger constraints;
+  /** The number of constraints that have been skipped because their items
+   are no longer part of the same view hierarchy. */
+  NSUInteger skippedConstraints;
+  /** The time spent declaring, naming and changing constraints. */
+  CFTimeInterval applyTime;
+  /** The time spent in `layoutIfNeeded` on the recorded root views. */
+  CFTimeInterval layoutTime;
+  /** `NO` if the stream was truncated or malformed. */
+  BOOL complete;
+} ALKLayoutReplayResult;
+
+/**
+ The `ALKLayoutRecorder` logs every constraint operation that goes through
+ *AutoLayoutKit* into a compact binary stream:
+ 
+ - `+layout:do:` entries,
+ - every constraint declared with `set:`/`make:`,
+ - named constraints added with `alk_addConstraint:withName:` and removed with
+ `alk_removeConstraintWithName:`,
+ - constant changes made through `alk_setConstant:forConstraintWithName:`,
+ - constraints activated, deactivated or rewritten by `+relayout:do:`,
+ `ALKLayoutVariants`, `ALKLayoutSnapshot` and `ALKConstraintRegistry` and
+ - views that have been moved to another superview after they were recorded.
+ 
+ Priorities are recorded as part of every constraint. Constants or activations
+ that are assigned to an `NSLayoutConstraint` directly bypass *AutoLayoutKit*
+ and are not recorded.
+ 
+ Recording is opt-in and costs a single pointer comparison per operation
+ while it is off:
+ 
+    ALKLayoutRecorder *recorder = [ALKLayoutRecorder startRecording];
+    // ... use the app ...
+    NSData *session = [recorder stopRecording];
+ 
+ A recorded session can then be replayed without the app, e.g. from a unit
+ test, to reproduce and profile a slow layout:
+ 
+    ALKLayoutReplayResult result = [ALKLayoutRecorder replay:session];
+ 
+ The recorder is not thread-safe and must only be used from the main thread.
+ 
+ @since 1.1.0
+ */
+@interface ALKLayoutRecorder : NSObject
+
+/**
+ The recorder that is currently recording or `nil` if recording is off.
+ 
+ @since 1.1.0
+ */
++ (nullable ALKLayoutRecorder *) activeRecorder;
+
+/**
+ Starts a new recording. A recording that is already running is stopped and
+ its data is discarded.
+ 
+ @since 1.1.0
+ */
++ (nonnull ALKLayoutRecorder *) startRecording;
+
+/**
+ Stops the recording.
+ 
+ @return The recorded stream.
+ 
+ @since 1.1.0
+ */
+- (nonnull NSData *) stopRecording;
+
+/**
+ The data that has been recorded so far.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, copy, readonly, nonnull) NSData * data;
+
+/**
+ Rebuilds the recorded views, replays every recorded operation on them and
+ lays out the result.
+ 
+ @param data A stream created by `stopRecording`.
+ 
+ @return Counters and timings of the replay.
+ 
+ @since 1.1.0
+ */
++ (ALKLayoutReplayResult) replay:(nonnull NSData *) data;
+
+/**
+ Works like `+replay:` and also returns the rebuilt views that have no
+ superview, e.g. to compare their frames with the recorded ones.
+ 
+ @param data A stream created by `stopRecording`.
+ @param rootViews Set to the rebuilt root views if not `NULL`.
+ 
+ @return Counters and timings of the replay.
+ 
+ @since 1.1.0
+ */
++ (ALKLayoutReplayResult) replay:(nonnull NSData *) data rootViews:(NSArray<UIView *> * _Nullable __autoreleasing * _Nullable) rootViews;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Recording Operations
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ Records the start of a `+layout:do:` block for `view`.
+ 
+ @since 1.1.0
+ */
+- (void) recordLayoutOfView:(nonnull UIView *) view;
+
+/**
+ Records a constraint that has been activated without a name. A constraint
+ that has been recorded before is recorded as reactivated.
+ 
+ @since 1.1.0
+ */
+- (void) recordConstraint:(nonnull NSLayoutConstraint *) constraint;
+
+/**
+ Records a constraint that has been added to `view` under `name`.
+ 
+ @since 1.1.0
+ */
+- (void) recordConstraint:(nonnull NSLayoutConstraint *) constraint
+                  addedTo:(nonnull UIView *) view
+                 withName:(nonnull NSString *) name;
+
+/**
+ Records the removal of the constraint named `name` from `view`.
+ 
+ @since 1.1.0
+ */
+- (void) recordRemovalFrom:(nonnull UIView *) view withName:(nonnull NSString *) name;
+
+/**
+ Records a new constant for the constraint named `name` on `view`.
+ 
+ @since 1.1.0
+ */
+- (void) recordConstant:(CGFloat) constant on:(nonnull UIView *) view withName:(nonnull NSString *) name;
+
+/**
+ Records constraints that have been activated, e.g. in one batch. Call it
+ after the constraints have been activated.
+ 
+ @since 1.1.0
+ */
+- (void) recordActivationOfConstraints:(nonnull NSArray<NSLayoutConstraint *> *) constraints;
+
+/**
+ Records constraints that have been deactivated. Constraints that have never
+ been recorded are skipped.
+ 
+ @since 1.1.0
+ */
+- (void) recordDeactivationOfConstraints:(nonnull NSArray<NSLayoutConstraint *> *) constraints;
+
+/**
+ Records the current constant and priority of a recorded constraint that has
+ been changed without its name.
+ 
+ @since 1.1.0
+ */
+- (void) recordValuesOfConstraint:(nonnull NSLayoutConstraint *) constraint;
+
+@end
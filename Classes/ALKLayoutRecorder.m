@@ -0,0 +1,640 @@
+//  ALKLayoutRecorder.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "ALKLayoutRecorder.h"
+#import "UIView+ALKNamedConstraints.h"
+
+/// Every stream starts with these four bytes followed by the format version.
+static const char kALKRecordMagic[4] = { 'A', 'L', 'K', 'R' };
+static uint8_t const kALKRecordVersion = 3;
+
+typedef NS_ENUM(uint8_t, ALKRecordOperation) {
+    /// id, kind, parent id, frame (4 x float32). Written before an item is used.
+    ALKRecordOperationItem          = 1,
+    /// id, length, UTF-8 bytes. Written before a string is used.
+    ALKRecordOperationString        = 2,
+    /// item id
+    ALKRecordOperationLayout        = 3,
+    /// constraint fields. Declares the next constraint id and activates it.
+    ALKRecordOperationConstraint    = 4,
+    /// owner id, name id, constraint fields. Declares the next constraint id.
+    ALKRecordOperationNamedAdd      = 5,
+    /// owner id, name id
+    ALKRecordOperationNamedRemove   = 6,
+    /// owner id, name id, constant (float64)
+    ALKRecordOperationConstant      = 7,
+    /// item id, parent id. Written when a declared view moved to another superview.
+    ALKRecordOperationParent        = 8,
+    /// constraint id. Reactivates a declared constraint.
+    ALKRecordOperationActivate      = 9,
+    /// constraint id
+    ALKRecordOperationDeactivate    = 10,
+    /// constraint id, constant (float64), priority (float32)
+    ALKRecordOperationValues        = 11,
+    /// owner id, name id, constraint id. Adds a declared constraint under a name.
+    ALKRecordOperationNamedAttach   = 12
+};
+
+typedef NS_ENUM(uint8_t, ALKRecordItemKind) {
+    ALKRecordItemKindView           = 0,
+    ALKRecordItemKindSafeAreaGuide  = 1
+};
+
+static ALKLayoutRecorder * activeRecorder = nil;
+
+@interface ALKLayoutRecorder ()
+
+@property (nonatomic, strong, nonnull) NSMutableData * stream;
+@property (nonatomic, strong, nonnull) NSMapTable * itemIDs;
+@property (nonatomic, strong, nonnull) NSMapTable * itemParentIDs;
+@property (nonatomic, assign) NSUInteger lastItemID;
+@property (nonatomic, strong, nonnull) NSMapTable * constraintIDs;
+@property (nonatomic, assign) NSUInteger lastConstraintID;
+@property (nonatomic, strong, nonnull) NSMutableDictionary<NSString *, NSNumber *> * stringIDs;
+
+@end
+
+@implementation ALKLayoutRecorder
+
++ (nullable ALKLayoutRecorder *) activeRecorder {
+    return activeRecorder;
+}
+
++ (nonnull ALKLayoutRecorder *) startRecording {
+    activeRecorder = [[ALKLayoutRecorder alloc] init];
+    return activeRecorder;
+}
+
+- (nonnull instancetype) init {
+    self = [super init];
+    if (self) {
+        self.stream = [NSMutableData dataWithBytes:kALKRecordMagic length:sizeof(kALKRecordMagic)];
+        [self.stream appendBytes:&kALKRecordVersion length:1];
+        self.itemIDs = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                             valueOptions:NSPointerFunctionsStrongMemory];
+        self.itemParentIDs = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                   valueOptions:NSPointerFunctionsStrongMemory];
+        self.constraintIDs = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                   valueOptions:NSPointerFunctionsStrongMemory];
+        self.stringIDs = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (nonnull NSData *) stopRecording {
+    if (activeRecorder == self) {
+        activeRecorder = nil;
+    }
+    return self.data;
+}
+
+- (nonnull NSData *) data {
+    return [self.stream copy];
+}
+
+#pragma mark - Recording Operations
+
+- (void) recordLayoutOfView:(nonnull UIView *) view {
+    NSUInteger itemID = [self idForItem:view];
+    writeByte(self.stream, ALKRecordOperationLayout);
+    writeVarint(self.stream, itemID);
+}
+
+- (void) recordConstraint:(nonnull NSLayoutConstraint *) constraint {
+    NSNumber *constraintID = [self.constraintIDs objectForKey:constraint];
+    if (constraintID) {
+        writeByte(self.stream, ALKRecordOperationActivate);
+        writeVarint(self.stream, constraintID.unsignedIntegerValue);
+        return;
+    }
+    
+    [self declareItemsOf:constraint];
+    writeByte(self.stream, ALKRecordOperationConstraint);
+    [self writeConstraint:constraint];
+    [self declareConstraint:constraint];
+}
+
+- (void) recordConstraint:(nonnull NSLayoutConstraint *) constraint
+                  addedTo:(nonnull UIView *) view
+                 withName:(nonnull NSString *) name {
+    NSUInteger ownerID = [self idForItem:view];
+    NSUInteger nameID = [self idForString:name];
+    
+    // a constraint that has been recorded before is added again, e.g. by a variant switch
+    NSNumber *constraintID = [self.constraintIDs objectForKey:constraint];
+    if (constraintID) {
+        writeByte(self.stream, ALKRecordOperationNamedAttach);
+        writeVarint(self.stream, ownerID);
+        writeVarint(self.stream, nameID);
+        writeVarint(self.stream, constraintID.unsignedIntegerValue);
+        return;
+    }
+    
+    [self declareItemsOf:constraint];
+    writeByte(self.stream, ALKRecordOperationNamedAdd);
+    writeVarint(self.stream, ownerID);
+    writeVarint(self.stream, nameID);
+    [self writeConstraint:constraint];
+    [self declareConstraint:constraint];
+}
+
+- (void) recordActivationOfConstraints:(nonnull NSArray<NSLayoutConstraint *> *) constraints {
+    for (NSLayoutConstraint *lc in constraints) {
+        [self recordConstraint:lc];
+    }
+}
+
+- (void) recordDeactivationOfConstraints:(nonnull NSArray<NSLayoutConstraint *> *) constraints {
+    for (NSLayoutConstraint *lc in constraints) {
+        // a constraint that has never been recorded is not part of the replayed layout
+        NSNumber *constraintID = [self.constraintIDs objectForKey:lc];
+        if (nil == constraintID) continue;
+        
+        writeByte(self.stream, ALKRecordOperationDeactivate);
+        writeVarint(self.stream, constraintID.unsignedIntegerValue);
+    }
+}
+
+- (void) recordValuesOfConstraint:(nonnull NSLayoutConstraint *) constraint {
+    // an unrecorded constraint is declared with its values once it is activated
+    NSNumber *constraintID = [self.constraintIDs objectForKey:constraint];
+    if (nil == constraintID) return;
+    
+    writeByte(self.stream, ALKRecordOperationValues);
+    writeVarint(self.stream, constraintID.unsignedIntegerValue);
+    writeDouble(self.stream, constraint.constant);
+    writeFloat(self.stream, constraint.priority);
+}
+
+- (void) recordRemovalFrom:(nonnull UIView *) view withName:(nonnull NSString *) name {
+    NSUInteger ownerID = [self idForItem:view];
+    NSUInteger nameID = [self idForString:name];
+    writeByte(self.stream, ALKRecordOperationNamedRemove);
+    writeVarint(self.stream, ownerID);
+    writeVarint(self.stream, nameID);
+}
+
+- (void) recordConstant:(CGFloat) constant on:(nonnull UIView *) view withName:(nonnull NSString *) name {
+    NSUInteger ownerID = [self idForItem:view];
+    NSUInteger nameID = [self idForString:name];
+    writeByte(self.stream, ALKRecordOperationConstant);
+    writeVarint(self.stream, ownerID);
+    writeVarint(self.stream, nameID);
+    writeDouble(self.stream, constant);
+}
+
+#pragma mark - Encoding
+
+/// Gives `constraint` the next constraint id. Like item ids, constraint ids
+/// start at 1 and are never reused. Replay assigns them in the same order.
+- (void) declareConstraint:(nonnull NSLayoutConstraint *) constraint {
+    [self.constraintIDs setObject:@(++self.lastConstraintID) forKey:constraint];
+}
+
+- (void) declareItemsOf:(nonnull NSLayoutConstraint *) constraint {
+    if (constraint.firstItem) [self idForItem:constraint.firstItem];
+    if (constraint.secondItem) [self idForItem:constraint.secondItem];
+}
+
+- (void) writeConstraint:(nonnull NSLayoutConstraint *) constraint {
+    writeVarint(self.stream, constraint.firstItem ? [self idForItem:constraint.firstItem] : 0);
+    writeVarint(self.stream, (NSUInteger)constraint.firstAttribute);
+    writeByte(self.stream, (uint8_t)(constraint.relation + 1));
+    writeVarint(self.stream, constraint.secondItem ? [self idForItem:constraint.secondItem] : 0);
+    writeVarint(self.stream, (NSUInteger)constraint.secondAttribute);
+    writeDouble(self.stream, constraint.multiplier);
+    writeDouble(self.stream, constraint.constant);
+    writeFloat(self.stream, constraint.priority);
+}
+
+/// Returns the id of `item`, declaring it (and its parents) first if needed.
+/// Ids start at 1 so that 0 can stand for "no item". They are never reused,
+/// even after a recorded item has been deallocated.
+- (NSUInteger) idForItem:(nonnull id) item {
+    NSNumber *itemID = [self.itemIDs objectForKey:item];
+    if (itemID) {
+        [self recordParentOf:item withID:itemID.unsignedIntegerValue];
+        return itemID.unsignedIntegerValue;
+    }
+    
+    ALKRecordItemKind kind = ALKRecordItemKindView;
+    UIView *parent = nil;
+    CGRect frame = CGRectZero;
+    
+    if ([item isKindOfClass:[UIView class]]) {
+        parent = ((UIView *)item).superview;
+        frame = ((UIView *)item).frame;
+    } else if ([item isKindOfClass:[UILayoutGuide class]]) {
+        kind = ALKRecordItemKindSafeAreaGuide;
+        parent = ((UILayoutGuide *)item).owningView;
+    }
+    
+    NSUInteger parentID = parent ? [self idForItem:parent] : 0;
+    NSUInteger newID = ++self.lastItemID;
+    [self.itemIDs setObject:@(newID) forKey:item];
+    [self.itemParentIDs setObject:@(parentID) forKey:item];
+    
+    writeByte(self.stream, ALKRecordOperationItem);
+    writeVarint(self.stream, newID);
+    writeByte(self.stream, kind);
+    writeVarint(self.stream, parentID);
+    writeFloat(self.stream, frame.origin.x);
+    writeFloat(self.stream, frame.origin.y);
+    writeFloat(self.stream, frame.size.width);
+    writeFloat(self.stream, frame.size.height);
+    
+    return newID;
+}
+
+/// Writes a parent operation if the declared view `item` has been moved to
+/// another superview since it was last used.
+- (void) recordParentOf:(nonnull id) item withID:(NSUInteger) itemID {
+    if (![item isKindOfClass:[UIView class]]) return;
+    
+    UIView *parent = ((UIView *)item).superview;
+    NSNumber *parentID = [self.itemIDs objectForKey:parent];
+    NSNumber *recordedParentID = [self.itemParentIDs objectForKey:item];
+    if (parent ? [parentID isEqual:recordedParentID] : recordedParentID.unsignedIntegerValue == 0) return;
+    
+    NSUInteger newParentID = parent ? [self idForItem:parent] : 0;
+    [self.itemParentIDs setObject:@(newParentID) forKey:item];
+    
+    writeByte(self.stream, ALKRecordOperationParent);
+    writeVarint(self.stream, itemID);
+    writeVarint(self.stream, newParentID);
+}
+
+- (NSUInteger) idForString:(nonnull NSString *) string {
+    NSNumber *stringID = self.stringIDs[string];
+    if (stringID) return stringID.unsignedIntegerValue;
+    
+    NSUInteger newID = self.stringIDs.count + 1;
+    self.stringIDs[string] = @(newID);
+    
+    NSData *bytes = [string dataUsingEncoding:NSUTF8StringEncoding];
+    writeByte(self.stream, ALKRecordOperationString);
+    writeVarint(self.stream, newID);
+    writeVarint(self.stream, bytes.length);
+    [self.stream appendData:bytes];
+    
+    return newID;
+}
+
+static void writeByte(NSMutableData * _Nonnull stream, uint8_t value) {
+    [stream appendBytes:&value length:1];
+}
+
+static void writeVarint(NSMutableData * _Nonnull stream, NSUInteger value) {
+    uint8_t bytes[10];
+    NSUInteger length = 0;
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        bytes[length++] = byte | (value ? 0x80 : 0x00);
+    } while (value);
+    [stream appendBytes:bytes length:length];
+}
+
+static void writeFloat(NSMutableData * _Nonnull stream, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits = CFSwapInt32HostToLittle(bits);
+    [stream appendBytes:&bits length:sizeof(bits)];
+}
+
+static void writeDouble(NSMutableData * _Nonnull stream, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits = CFSwapInt64HostToLittle(bits);
+    [stream appendBytes:&bits length:sizeof(bits)];
+}
+
+#pragma mark - Replay
+
+typedef struct {
+    const uint8_t * bytes;
+    NSUInteger length;
+    NSUInteger offset;
+    BOOL failed;
+} ALKRecordReader;
+
++ (ALKLayoutReplayResult) replay:(nonnull NSData *) data {
+    return [self replay:data rootViews:NULL];
+}
+
++ (ALKLayoutReplayResult) replay:(nonnull NSData *) data rootViews:(NSArray<UIView *> * _Nullable __autoreleasing * _Nullable) rootViews {
+    ALKLayoutReplayResult result = { 0, 0, 0, 0.0, 0.0, NO };
+    ALKRecordReader reader = { data.bytes, data.length, 0, NO };
+    
+    char magic[sizeof(kALKRecordMagic)];
+    if (!readBytes(&reader, magic, sizeof(magic)) || memcmp(magic, kALKRecordMagic, sizeof(magic)) != 0) return result;
+    if (readByte(&reader) != kALKRecordVersion) return result;
+    
+    // replaying must not end up in the recording that is replayed
+    ALKLayoutRecorder *recorder = activeRecorder;
+    activeRecorder = nil;
+    
+    NSMutableDictionary<NSNumber *, id> *items = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSNumber *, NSString *> *strings = [NSMutableDictionary dictionary];
+    NSMutableArray<UIView *> *roots = [NSMutableArray array];
+    
+    // indexed by constraint id - 1, NSNull for constraints that could not be declared
+    NSMutableArray *constraints = [NSMutableArray array];
+    
+    CFTimeInterval start = CACurrentMediaTime();
+    
+    while (!reader.failed && reader.offset < reader.length) {
+        ALKRecordOperation operation = readByte(&reader);
+        
+        switch (operation) {
+            case ALKRecordOperationItem: {
+                NSUInteger itemID = readVarint(&reader);
+                ALKRecordItemKind kind = readByte(&reader);
+                id parent = items[@(readVarint(&reader))];
+                CGRect frame;
+                frame.origin.x = readFloat(&reader);
+                frame.origin.y = readFloat(&reader);
+                frame.size.width = readFloat(&reader);
+                frame.size.height = readFloat(&reader);
+                
+                id item = nil;
+                if (kind == ALKRecordItemKindSafeAreaGuide) {
+                    item = parent;
+                    if (@available(iOS 11, *)) {
+                        item = ((UIView *)parent).safeAreaLayoutGuide;
+                    }
+                } else {
+                    UIView *view = [[UIView alloc] initWithFrame:frame];
+                    if ([parent isKindOfClass:[UIView class]]) {
+                        [(UIView *)parent addSubview:view];
+                    } else {
+                        [roots addObject:view];
+                    }
+                    item = view;
+                }
+                
+                if (item) items[@(itemID)] = item;
+                break;
+            }
+            case ALKRecordOperationString: {
+                NSUInteger stringID = readVarint(&reader);
+                NSUInteger length = readVarint(&reader);
+                NSMutableData *bytes = [NSMutableData dataWithLength:length];
+                if (readBytes(&reader, bytes.mutableBytes, length)) {
+                    strings[@(stringID)] = [[NSString alloc] initWithData:bytes encoding:NSUTF8StringEncoding];
+                }
+                break;
+            }
+            case ALKRecordOperationLayout: {
+                UIView *view = items[@(readVarint(&reader))];
+                view.translatesAutoresizingMaskIntoConstraints = NO;
+                break;
+            }
+            case ALKRecordOperationConstraint: {
+                NSLayoutConstraint *lc = readConstraint(&reader, items);
+                [constraints addObject:lc ?: [NSNull null]];
+                if (lc && !constraintIsInstallable(lc)) {
+                    result.skippedConstraints++;
+                    break;
+                }
+                lc.active = YES;
+                result.constraints += lc ? 1 : 0;
+                break;
+            }
+            case ALKRecordOperationNamedAdd: {
+                UIView *owner = items[@(readVarint(&reader))];
+                NSString *name = strings[@(readVarint(&reader))];
+                NSLayoutConstraint *lc = readConstraint(&reader, items);
+                [constraints addObject:lc ?: [NSNull null]];
+                if (lc && !constraintIsInstallable(lc)) {
+                    result.skippedConstraints++;
+                    break;
+                }
+                if (lc && name) {
+                    [owner alk_addConstraint:lc withName:name];
+                }
+                result.constraints += lc ? 1 : 0;
+                break;
+            }
+            case ALKRecordOperationNamedRemove: {
+                UIView *owner = items[@(readVarint(&reader))];
+                NSString *name = strings[@(readVarint(&reader))];
+                [owner alk_removeConstraintWithName:name];
+                break;
+            }
+            case ALKRecordOperationConstant: {
+                UIView *owner = items[@(readVarint(&reader))];
+                NSString *name = strings[@(readVarint(&reader))];
+                CGFloat constant = readDouble(&reader);
+                [owner alk_setConstant:constant forConstraintWithName:name];
+                break;
+            }
+            case ALKRecordOperationParent: {
+                UIView *view = items[@(readVarint(&reader))];
+                NSUInteger parentID = readVarint(&reader);
+                UIView *parent = items[@(parentID)];
+                if (![view isKindOfClass:[UIView class]] || (parentID && ![parent isKindOfClass:[UIView class]])) break;
+                if (parent == view.superview || [parent isDescendantOfView:view]) break;
+                
+                if (parent) {
+                    [parent addSubview:view];
+                    [roots removeObject:view];
+                } else {
+                    [view removeFromSuperview];
+                    [roots addObject:view];
+                }
+                break;
+            }
+            case ALKRecordOperationActivate: {
+                NSLayoutConstraint *lc = constraintWithID(constraints, readVarint(&reader));
+                if (lc && !constraintIsInstallable(lc)) {
+                    result.skippedConstraints++;
+                    break;
+                }
+                lc.active = YES;
+                break;
+            }
+            case ALKRecordOperationDeactivate: {
+                NSLayoutConstraint *lc = constraintWithID(constraints, readVarint(&reader));
+                lc.active = NO;
+                break;
+            }
+            case ALKRecordOperationValues: {
+                NSLayoutConstraint *lc = constraintWithID(constraints, readVarint(&reader));
+                CGFloat constant = readDouble(&reader);
+                UILayoutPriority priority = readFloat(&reader);
+                if (nil == lc || reader.failed) break;
+                
+                // an installed constraint cannot switch between required and optional, the
+                // recording reactivates it afterwards
+                if (lc.active && (lc.priority == UILayoutPriorityRequired) != (priority == UILayoutPriorityRequired)) {
+                    lc.active = NO;
+                }
+                lc.priority = priority;
+                lc.constant = constant;
+                break;
+            }
+            case ALKRecordOperationNamedAttach: {
+                UIView *owner = items[@(readVarint(&reader))];
+                NSString *name = strings[@(readVarint(&reader))];
+                NSLayoutConstraint *lc = constraintWithID(constraints, readVarint(&reader));
+                if (lc && !constraintIsInstallable(lc)) {
+                    result.skippedConstraints++;
+                    break;
+                }
+                if (lc && name) {
+                    [owner alk_addConstraint:lc withName:name];
+                }
+                break;
+            }
+            default:
+                reader.failed = YES;
+                break;
+        }
+        
+        result.operations += reader.failed ? 0 : 1;
+    }
+    
+    result.applyTime = CACurrentMediaTime() - start;
+    
+    start = CACurrentMediaTime();
+    for (UIView *root in roots) {
+        [root layoutIfNeeded];
+    }
+    result.layoutTime = CACurrentMediaTime() - start;
+    result.complete = !reader.failed;
+    
+    activeRecorder = recorder;
+    
+    if (rootViews) {
+        *rootViews = [roots copy];
+    }
+    
+    return result;
+}
+
+/// Returns `YES` if both items of `constraint` are part of the same view
+/// hierarchy. Activating a constraint between unrelated views throws, which
+/// can happen when a recorded view has been re-parented or deallocated.
+static BOOL constraintIsInstallable(NSLayoutConstraint * _Nonnull constraint) {
+    UIView *view = owningViewOfItem(constraint.firstItem);
+    UIView *relatedView = owningViewOfItem(constraint.secondItem);
+    if (nil == view) return NO;
+    if (nil == constraint.secondItem) return YES;
+    if (nil == relatedView) return NO;
+    
+    UIView *root = view;
+    while (root.superview) root = root.superview;
+    UIView *relatedRoot = relatedView;
+    while (relatedRoot.superview) relatedRoot = relatedRoot.superview;
+    return root == relatedRoot;
+}
+
+static UIView * _Nullable owningViewOfItem(id _Nullable item) {
+    if ([item isKindOfClass:[UIView class]]) return item;
+    if ([item isKindOfClass:[UILayoutGuide class]]) return ((UILayoutGuide *)item).owningView;
+    return nil;
+}
+
+static NSLayoutConstraint * _Nullable constraintWithID(NSArray * _Nonnull constraints, NSUInteger constraintID) {
+    if (constraintID == 0 || constraintID > constraints.count) return nil;
+    id lc = constraints[constraintID - 1];
+    return [lc isKindOfClass:[NSLayoutConstraint class]] ? lc : nil;
+}
+
+/// Reads recorded constraint fields and creates an inactive constraint from
+/// them. A shared constraint is only recorded by its first declaration, so
+/// every constraint op stands for a constraint of its own.
+static NSLayoutConstraint * _Nullable readConstraint(ALKRecordReader * _Nonnull reader, NSDictionary<NSNumber *, id> * _Nonnull items) {
+    id item = items[@(readVarint(reader))];
+    NSLayoutAttribute attribute = (NSLayoutAttribute)readVarint(reader);
+    NSLayoutRelation relation = (NSLayoutRelation)((NSInteger)readByte(reader) - 1);
+    NSUInteger relatedID = readVarint(reader);
+    id relatedItem = relatedID ? items[@(relatedID)] : nil;
+    NSLayoutAttribute relatedAttribute = (NSLayoutAttribute)readVarint(reader);
+    CGFloat multiplier = readDouble(reader);
+    CGFloat constant = readDouble(reader);
+    UILayoutPriority priority = readFloat(reader);
+    
+    if (reader->failed || nil == item || (relatedID && nil == relatedItem)) return nil;
+    
+    NSLayoutConstraint *lc = [NSLayoutConstraint constraintWithItem:item
+                                      attribute:attribute
+                                      relatedBy:relation
+                                         toItem:relatedItem
+                                      attribute:relatedAttribute
+                                     multiplier:multiplier
+                                       constant:constant];
+    lc.priority = priority;
+    return lc;
+}
+
+static BOOL readBytes(ALKRecordReader * _Nonnull reader, void * _Nonnull buffer, NSUInteger length) {
+    if (reader->failed || length > reader->length - reader->offset) {
+        reader->failed = YES;
+        return NO;
+    }
+    memcpy(buffer, reader->bytes + reader->offset, length);
+    reader->offset += length;
+    return YES;
+}
+
+static uint8_t readByte(ALKRecordReader * _Nonnull reader) {
+    uint8_t value = 0;
+    readBytes(reader, &value, 1);
+    return value;
+}
+
+static NSUInteger readVarint(ALKRecordReader * _Nonnull reader) {
+    NSUInteger value = 0;
+    for (NSUInteger shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = readByte(reader);
+        value |= (NSUInteger)(byte & 0x7F) << shift;
+        if (reader->failed || !(byte & 0x80)) return value;
+    }
+    reader->failed = YES;
+    return 0;
+}
+
+static float readFloat(ALKRecordReader * _Nonnull reader) {
+    uint32_t bits = 0;
+    readBytes(reader, &bits, sizeof(bits));
+    bits = CFSwapInt32LittleToHost(bits);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static double readDouble(ALKRecordReader * _Nonnull reader) {
+    uint64_t bits = 0;
+    readBytes(reader, &bits, sizeof(bits));
+    bits = CFSwapInt64LittleToHost(bits);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+@end
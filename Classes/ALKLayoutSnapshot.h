@@ -0,0 +1,116 @@
+//  ALKLayoutSnapshot.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+/**
+ An immutable capture of the layout state of a view subtree: the installed
+ constraints of every view with their constants and priorities, the
+ registered names and the solved frames.
+ 
+    ALKLayoutSnapshot *editing = [ALKLayoutSnapshot snapshotOfView:self.view];
+    // ... switch to the preview layout ...
+    ALKLayoutSnapshot *preview = [ALKLayoutSnapshot snapshotOfView:self.view sharingWith:editing];
+    
+    [editing restore];
+ 
+ The state of a view is kept in its own immutable record. A snapshot that is
+ taken with a previous snapshot reuses the records of all views that have not
+ changed since, so alternating between a few layouts only copies the views
+ that differ between them.
+ 
+ Restoring reuses the captured `NSLayoutConstraint` instances. It only
+ deactivates, activates and updates the constraints that differ from the
+ current state, so the layout engine keeps everything else and does not have
+ to rebuild the layout.
+ 
+ @since 1.1.0
+ */
+@interface ALKLayoutSnapshot : NSObject
+
+/**
+ Captures the state of `view` and its subviews.
+ 
+ @param view The root of the subtree.
+ 
+ @since 1.1.0
+ */
++ (nonnull instancetype) snapshotOfView:(nonnull UIView *) view;
+
+/**
+ Captures the state of `view` and its subviews, sharing the records of all
+ views whose state is the same as in `previous`.
+ 
+ @param view The root of the subtree.
+ @param previous An earlier snapshot, usually of the same subtree.
+ 
+ @since 1.1.0
+ */
++ (nonnull instancetype) snapshotOfView:(nonnull UIView *) view sharingWith:(nullable ALKLayoutSnapshot *) previous;
+
+/**
+ The number of captured views.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger viewCount;
+
+/**
+ The number of captured constraints.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger constraintCount;
+
+/**
+ The number of views whose record is shared with the previous snapshot.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger sharedViewCount;
+
+/**
+ The frame `view` had when the snapshot has been taken.
+ 
+ @param view A view of the captured subtree.
+ 
+ @return The frame or `CGRectNull` if the view is not part of the snapshot.
+ 
+ @since 1.1.0
+ */
+- (CGRect) frameOfView:(nonnull UIView *) view;
+
+/**
+ Returns all captured views that are still alive to the captured state.
+ Views that have been added since are not touched, except for constraints
+ installed on captured views.
+ 
+ @return The number of constraints that have been activated, deactivated or
+ changed.
+ 
+ @since 1.1.0
+ */
+- (NSUInteger) restore;
+
+@end
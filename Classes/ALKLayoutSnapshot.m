@@ -0,0 +1,308 @@
+//  ALKLayoutSnapshot.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKLayoutSnapshot.h"
+#import "ALKLayoutRecorder.h"
+#import "UIView+ALKNamedConstraints.h"
+
+/**
+ The immutable state of a single view. Constants and priorities are stored in
+ flat arrays parallel to `constraints`.
+ */
+@interface ALKViewLayoutState : NSObject {
+@public
+    CGFloat *_constants;
+    UILayoutPriority *_priorities;
+    /// constraint -> index into the flat arrays, built when the order differs first
+    NSMapTable<NSLayoutConstraint *, NSNumber *> *_indexes;
+}
+
+@property (nonatomic, weak, readonly, nullable) UIView * view;
+@property (nonatomic, copy, readonly, nonnull) NSArray<NSLayoutConstraint *> * constraints;
+@property (nonatomic, copy, readonly, nullable) NSDictionary<NSString *, NSLayoutConstraint *> * names;
+@property (nonatomic, assign, readonly) CGRect frame;
+
+- (nonnull instancetype) initWithView:(nonnull UIView *) view
+                          constraints:(nonnull NSArray<NSLayoutConstraint *> *) constraints
+                                names:(nullable NSDictionary *) names;
+
+- (BOOL) matchesConstraints:(nonnull NSArray<NSLayoutConstraint *> *) constraints names:(nullable NSDictionary *) names;
+- (NSUInteger) indexOfConstraint:(nonnull NSLayoutConstraint *) constraint;
+
+@end
+
+@implementation ALKViewLayoutState
+
+- (nonnull instancetype) initWithView:(nonnull UIView *) view
+                          constraints:(nonnull NSArray<NSLayoutConstraint *> *) constraints
+                                names:(nullable NSDictionary *) names {
+    self = [super init];
+    if (self) {
+        _view = view;
+        _constraints = [constraints copy];
+        _names = names.count > 0 ? [names copy] : nil;
+        _frame = view.frame;
+        
+        NSUInteger count = constraints.count;
+        _constants = count > 0 ? malloc(count * sizeof(CGFloat)) : NULL;
+        _priorities = count > 0 ? malloc(count * sizeof(UILayoutPriority)) : NULL;
+        for (NSUInteger i = 0; i < count; i++) {
+            _constants[i] = constraints[i].constant;
+            _priorities[i] = constraints[i].priority;
+        }
+    }
+    return self;
+}
+
+- (void) dealloc {
+    free(_constants);
+    free(_priorities);
+}
+
+- (BOOL) matchesConstraints:(nonnull NSArray<NSLayoutConstraint *> *) constraints names:(nullable NSDictionary *) names {
+    if (constraints.count != _constraints.count) return NO;
+    if ((names.count > 0 || _names) && ![_names isEqualToDictionary:names]) return NO;
+    
+    // the order of `-[UIView constraints]` is not guaranteed, compare as sets
+    NSUInteger i = 0;
+    for (NSLayoutConstraint *lc in constraints) {
+        NSUInteger index = (lc == _constraints[i]) ? i : [self indexOfConstraint:lc];
+        if (index == NSNotFound || lc.constant != _constants[index] || lc.priority != _priorities[index]) return NO;
+        i++;
+    }
+    return YES;
+}
+
+- (NSUInteger) indexOfConstraint:(nonnull NSLayoutConstraint *) constraint {
+    if (nil == _indexes) {
+        _indexes = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                         valueOptions:NSPointerFunctionsStrongMemory];
+        [_constraints enumerateObjectsUsingBlock:^(NSLayoutConstraint *lc, NSUInteger idx, BOOL *stop) {
+            [self->_indexes setObject:@(idx) forKey:lc];
+        }];
+    }
+    
+    NSNumber *index = [_indexes objectForKey:constraint];
+    return index ? index.unsignedIntegerValue : NSNotFound;
+}
+
+@end
+
+@interface ALKLayoutSnapshot ()
+
+@property (nonatomic, assign, readwrite) NSUInteger constraintCount;
+@property (nonatomic, assign, readwrite) NSUInteger sharedViewCount;
+
+@end
+
+@implementation ALKLayoutSnapshot {
+    /// depth first, parents before their subviews
+    NSArray<ALKViewLayoutState *> *_states;
+    /// view -> state, for sharing and `frameOfView:`
+    NSMapTable<UIView *, ALKViewLayoutState *> *_statesByView;
+}
+
++ (nonnull instancetype) snapshotOfView:(nonnull UIView *) view {
+    return [self snapshotOfView:view sharingWith:nil];
+}
+
++ (nonnull instancetype) snapshotOfView:(nonnull UIView *) view sharingWith:(nullable ALKLayoutSnapshot *) previous {
+    ALKLayoutSnapshot *snapshot = [[ALKLayoutSnapshot alloc] init];
+    [snapshot captureView:view previous:previous];
+    return snapshot;
+}
+
+- (NSUInteger) viewCount {
+    return _states.count;
+}
+
+- (CGRect) frameOfView:(nonnull UIView *) view {
+    ALKViewLayoutState *state = [_statesByView objectForKey:view];
+    return state ? state.frame : CGRectNull;
+}
+
+#pragma mark - Capturing
+
+- (void) captureView:(nonnull UIView *) root previous:(nullable ALKLayoutSnapshot *) previous {
+    // asking a view for its names would create an empty table, only views that have one are asked
+    NSHashTable *namedViews = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    for (UIView *view in [UIView alk_viewsWithNamedConstraints]) {
+        [namedViews addObject:view];
+    }
+    
+    NSMutableArray *states = [NSMutableArray array];
+    NSMapTable *statesByView = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                                     valueOptions:NSPointerFunctionsStrongMemory];
+    NSUInteger constraintCount = 0;
+    NSUInteger sharedViewCount = 0;
+    
+    NSMutableArray<UIView *> *stack = [NSMutableArray arrayWithObject:root];
+    while (stack.count > 0) {
+        UIView *view = [stack lastObject];
+        [stack removeLastObject];
+        
+        NSArray *constraints = capturedConstraints(view);
+        NSDictionary *names = [namedViews containsObject:view] ? view.alk_namedConstraints : nil;
+        
+        ALKViewLayoutState *state = previous ? [previous->_statesByView objectForKey:view] : nil;
+        if (state && CGRectEqualToRect(state.frame, view.frame) && [state matchesConstraints:constraints names:names]) {
+            sharedViewCount++;
+        } else {
+            state = [[ALKViewLayoutState alloc] initWithView:view constraints:constraints names:names];
+        }
+        
+        [states addObject:state];
+        [statesByView setObject:state forKey:view];
+        constraintCount += constraints.count;
+        
+        [stack addObjectsFromArray:[[view.subviews reverseObjectEnumerator] allObjects]];
+    }
+    
+    _states = states;
+    _statesByView = statesByView;
+    self.constraintCount = constraintCount;
+    self.sharedViewCount = sharedViewCount;
+}
+
+#pragma mark - Restoring
+
+- (NSUInteger) restore {
+    NSHashTable *namedViews = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    for (UIView *view in [UIView alk_viewsWithNamedConstraints]) {
+        [namedViews addObject:view];
+    }
+    
+    NSMutableArray<NSLayoutConstraint *> *deactivate = [NSMutableArray array];
+    NSMutableArray<NSLayoutConstraint *> *activate = [NSMutableArray array];
+    NSMutableArray<ALKViewLayoutState *> *touched = [NSMutableArray array];
+    ALKLayoutRecorder *recorder = [ALKLayoutRecorder activeRecorder];
+    __block NSUInteger changed = 0;
+    
+    for (ALKViewLayoutState *state in _states) {
+        UIView *view = state.view;
+        if (nil == view) continue;
+        
+        NSArray<NSLayoutConstraint *> *constraints = capturedConstraints(view);
+        NSDictionary *names = [namedViews containsObject:view] ? view.alk_namedConstraints : nil;
+        if ([state matchesConstraints:constraints names:names]) continue;
+        
+        // names that have been added or reassigned since
+        for (NSString *name in [names allKeys]) {
+            if (state.names[name] != names[name]) {
+                [view alk_removeConstraintWithName:name];
+                changed++;
+            }
+        }
+        
+        NSHashTable *captured = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+        for (NSLayoutConstraint *lc in state.constraints) {
+            [captured addObject:lc];
+        }
+        for (NSLayoutConstraint *lc in constraints) {
+            if (lc.active && ![captured containsObject:lc]) [deactivate addObject:lc];
+        }
+        
+        [state.constraints enumerateObjectsUsingBlock:^(NSLayoutConstraint *lc, NSUInteger i, BOOL *stop) {
+            UILayoutPriority priority = state->_priorities[i];
+            BOOL rewritten = NO;
+            if (lc.priority != priority) {
+                // an installed constraint cannot switch between required and optional
+                if (lc.active && (lc.priority == UILayoutPriorityRequired) != (priority == UILayoutPriorityRequired)) {
+                    lc.active = NO;
+                }
+                lc.priority = priority;
+                rewritten = YES;
+                changed++;
+            }
+            if (lc.constant != state->_constants[i]) {
+                lc.constant = state->_constants[i];
+                rewritten = YES;
+                changed++;
+            }
+            if (rewritten) [recorder recordValuesOfConstraint:lc];
+        }];
+        
+        [touched addObject:state];
+    }
+    
+    [NSLayoutConstraint deactivateConstraints:deactivate];
+    [recorder recordDeactivationOfConstraints:deactivate];
+    changed += deactivate.count;
+    
+    // after all deactivations, so a constraint that moved between views is activated once
+    for (ALKViewLayoutState *state in touched) {
+        for (NSLayoutConstraint *lc in state.constraints) {
+            if (!lc.active && itemsShareHierarchy(lc)) [activate addObject:lc];
+        }
+    }
+    [NSLayoutConstraint activateConstraints:activate];
+    [recorder recordActivationOfConstraints:activate];
+    changed += activate.count;
+    
+    for (ALKViewLayoutState *state in touched) {
+        UIView *view = state.view;
+        [state.names enumerateKeysAndObjectsUsingBlock:^(NSString *name, NSLayoutConstraint *lc, BOOL *stop) {
+            if ([view alk_constraintWithName:name] != lc) [view alk_addConstraint:lc withName:name];
+        }];
+    }
+    
+    return changed;
+}
+
+#pragma mark - Functions
+
+static UIView * _Nullable owningView(id _Nullable item) {
+    if ([item isKindOfClass:[UIView class]]) return item;
+    if (@available(iOS 9, *)) {
+        if ([item isKindOfClass:[UILayoutGuide class]]) return ((UILayoutGuide *)item).owningView;
+    }
+    return nil;
+}
+
+static BOOL itemsShareHierarchy(NSLayoutConstraint * _Nonnull constraint) {
+    // activating a constraint between views that have been moved apart since would throw
+    UIView *first = owningView(constraint.firstItem);
+    UIView *second = owningView(constraint.secondItem);
+    if (nil == first) return NO;
+    if (nil == constraint.secondItem) return YES;
+    if (nil == second) return NO;
+    
+    UIView *root = first;
+    while (root.superview) root = root.superview;
+    return [second isDescendantOfView:root];
+}
+
+static NSArray<NSLayoutConstraint *> * _Nonnull capturedConstraints(UIView * _Nonnull view) {
+    // UIKit adds and updates these on its own
+    NSMutableArray *constraints = [NSMutableArray arrayWithCapacity:view.constraints.count];
+    for (NSLayoutConstraint *lc in view.constraints) {
+        NSString *className = NSStringFromClass([lc class]);
+        if ([className isEqualToString:@"NSAutoresizingMaskLayoutConstraint"] ||
+            [className isEqualToString:@"NSContentSizeLayoutConstraint"]) continue;
+        [constraints addObject:lc];
+    }
+    return constraints;
+}
+
+@end
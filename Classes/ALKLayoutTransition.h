@@ -0,0 +1,96 @@
+//  ALKLayoutTransition.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+/**
+ The `ALKLayoutTransition` solves the layout of a view subtree before and after
+ a change once and moves the subviews between both by interpolating their
+ frames, without solving the layout again for intermediate steps.
+ 
+    self.transition = [ALKLayoutTransition transitionOfView:self.view changes:^{
+        [self.cardView alk_setConstant:0.f forConstraintWithName:@"top"];
+    }];
+    
+    // in the gesture handler
+    self.transition.progress = translation.y / distance;
+    
+    // when the gesture ends
+    if (velocity.y > 0.f) [self.transition finish]; else [self.transition cancel];
+ 
+ The frames of both layouts are kept in flat buffers and only the views that
+ actually move between them are touched while the progress changes. They are
+ applied from the root down and every resized view is laid out right away, so
+ the subviews of nested containers keep their frames through later layout
+ passes.
+ 
+ A layout pass of the subtree during the transition moves every view to the
+ end layout, so nothing should call `setNeedsLayout` on it until the
+ transition has been finished or cancelled.
+ 
+ @since 1.1.0
+ */
+@interface ALKLayoutTransition : NSObject
+
+/**
+ Lays out `view`, applies `changes` and lays it out again, then returns the
+ subviews to the start layout (`progress == 0`).
+ 
+ @param view The root of the subtree, its own frame is not changed.
+ @param changes Changes the constraints of the subtree, e.g. their constants.
+ 
+ @since 1.1.0
+ */
++ (nonnull instancetype) transitionOfView:(nonnull UIView *) view changes:(nonnull void (^)(void)) changes;
+
+/**
+ The position between the start (`0`) and the end layout (`1`). Values outside
+ of that range extrapolate, e.g. for rubber banding.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign) CGFloat progress;
+
+/**
+ The number of views whose frames differ between both layouts.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger movingViewCount;
+
+/**
+ Moves all views to the end layout, which the layout engine keeps from then on.
+ 
+ @since 1.1.0
+ */
+- (void) finish;
+
+/**
+ Restores the constraints of the start layout and lays the subtree out again.
+ 
+ @since 1.1.0
+ */
+- (void) cancel;
+
+@end
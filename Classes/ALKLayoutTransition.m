@@ -0,0 +1,145 @@
+//  ALKLayoutTransition.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKLayoutTransition.h"
+#import "ALKLayoutSnapshot.h"
+#import "ALKViewTraversal.h"
+
+@implementation ALKLayoutTransition {
+    UIView *_root;
+    ALKLayoutSnapshot *_start;
+    
+    /// the moving views and their frames, parallel arrays
+    NSArray<UIView *> *_views;
+    CGRect *_from;
+    CGRect *_to;
+    CGRect *_frames;
+}
+
++ (nonnull instancetype) transitionOfView:(nonnull UIView *) view changes:(nonnull void (^)(void)) changes {
+    ALKLayoutTransition *transition = [[ALKLayoutTransition alloc] initWithView:view];
+    [transition solveWithChanges:changes];
+    return transition;
+}
+
+- (nonnull instancetype) initWithView:(nonnull UIView *) view {
+    self = [super init];
+    if (self) {
+        _root = view;
+    }
+    return self;
+}
+
+- (void) dealloc {
+    free(_from);
+    free(_to);
+    free(_frames);
+}
+
+- (NSUInteger) movingViewCount {
+    return _views.count;
+}
+
+#pragma mark - Solving
+
+- (void) solveWithChanges:(nonnull void (^)(void)) changes {
+    [_root layoutIfNeeded];
+    
+    NSArray<UIView *> *views = ALKSubviewsOfView(_root);
+    NSUInteger count = views.count;
+    CGRect *from = malloc(MAX(count, (NSUInteger)1) * sizeof(CGRect));
+    for (NSUInteger i = 0; i < count; i++) {
+        from[i] = views[i].frame;
+    }
+    
+    _start = [ALKLayoutSnapshot snapshotOfView:_root];
+    changes();
+    [_root layoutIfNeeded];
+    
+    // keep only the views that move, in place
+    NSMutableArray<UIView *> *moving = [NSMutableArray array];
+    CGRect *to = malloc(MAX(count, (NSUInteger)1) * sizeof(CGRect));
+    NSUInteger movingCount = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        CGRect frame = views[i].frame;
+        if (CGRectEqualToRect(frame, from[i])) continue;
+        
+        from[movingCount] = from[i];
+        to[movingCount] = frame;
+        movingCount++;
+        [moving addObject:views[i]];
+    }
+    
+    _views = moving;
+    _from = from;
+    _to = to;
+    _frames = malloc(MAX(movingCount, (NSUInteger)1) * sizeof(CGRect));
+    
+    self.progress = 0.f;
+}
+
+#pragma mark - Progress
+
+- (void) setProgress:(CGFloat) progress {
+    _progress = progress;
+    
+    NSUInteger count = _views.count;
+    interpolateFrames(_from, _to, _frames, count, progress);
+    
+    // the views are ordered containers first, so each container is laid out
+    // right after it is resized and puts its subviews at the end layout before
+    // they get their own frames; no view is left needing layout, which would
+    // move its subviews back to the end layout on the next pass
+    [_root layoutIfNeeded];
+    for (NSUInteger i = 0; i < count; i++) {
+        UIView *view = _views[i];
+        view.frame = _frames[i];
+        [view layoutIfNeeded];
+    }
+}
+
+- (void) finish {
+    self.progress = 1.f;
+}
+
+- (void) cancel {
+    [_start restore];
+    [_root layoutIfNeeded];
+    _progress = 0.f;
+}
+
+#pragma mark - Functions
+
+static void interpolateFrames(const CGRect * _Nonnull from, const CGRect * _Nonnull to, CGRect * _Nonnull frames, NSUInteger count, CGFloat progress) {
+    // a CGRect is four CGFloats, so the buffers can be treated as flat arrays the compiler vectorizes
+    const CGFloat *a = (const CGFloat *)from;
+    const CGFloat *b = (const CGFloat *)to;
+    CGFloat *out = (CGFloat *)frames;
+    NSUInteger n = count * 4;
+    for (NSUInteger i = 0; i < n; i++) {
+        out[i] = a[i] + (b[i] - a[i]) * progress;
+    }
+}
+
+@end
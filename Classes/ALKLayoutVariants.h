@@ -0,0 +1,125 @@
+//  ALKLayoutVariants.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+/**
+ The `ALKLayoutVariants` of a view hold alternative sets of constraints, e.g.
+ for a compact and a regular layout or for an editing and a viewing state, and
+ switch between them.
+ 
+ Variants are declared once inside `+[ALKConstraints layout:do:]` blocks with
+ `-[ALKConstraints variant:on:do:]`. Their constraints are created right away
+ but only the constraints of the current variant are active.
+ 
+    [ALKConstraints layout:self.avatarView do:^(ALKConstraints *c) {
+      [c make:ALKTop equalTo:self s:ALKTop plus:10.f];
+      [c variant:@"compact" on:self do:^(ALKConstraints *c) {
+        [c set:ALKWidth to:40.f];
+        [c make:ALKLeft equalTo:self s:ALKLeft plus:10.f];
+      }];
+      [c variant:@"regular" on:self do:^(ALKConstraints *c) {
+        [c set:ALKWidth to:80.f];
+        [c make:ALKCenterX equalTo:self s:ALKCenterX];
+      }];
+    }];
+ 
+    [[ALKLayoutVariants variantsOfView:self] switchToVariant:@"regular"];
+ 
+ A switch only deactivates the constraints that the new variant does not
+ share with the current one and activates those it adds, each in one batch.
+ The delta between two variants is computed on their first switch and reused
+ afterwards, so a switch costs time proportional to the delta and not to the
+ size of the layout. Unnamed constraints that are declared identically in
+ several variants of the same view are shared and stay active.
+ 
+ Named constraints of a variant are registered under their name (see
+ `UIView+ALKNamedConstraints`) while the variant is current.
+ 
+ @since 1.1.0
+ */
+@interface ALKLayoutVariants : NSObject
+
+/**
+ The variants stored on `view`, created on first use.
+ 
+ @since 1.1.0
+ */
++ (nonnull instancetype) variantsOfView:(nonnull UIView *) view;
+
+/**
+ The tag of the variant whose constraints are active, `nil` before the first
+ switch.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, copy, readonly, nullable) NSString * currentVariant;
+
+/**
+ The tags of all declared variants in declaration order.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, strong, readonly, nonnull) NSArray<NSString *> * variantTags;
+
+/**
+ The number of constraints declared for the variant `tag`.
+ 
+ @since 1.1.0
+ */
+- (NSUInteger) constraintCountOfVariant:(nonnull NSString *) tag;
+
+/**
+ Adds `constraint` to the variant `tag`. You should not have to call this
+ directly, it is used by `-[ALKConstraints variant:on:do:]`.
+ 
+ @param constraint An inactive constraint.
+ @param tag The tag of the variant.
+ @param targetView The view that stores the name of the constraint.
+ @param name The name of the constraint or `nil`.
+ 
+ @return `constraint`, or the equal unnamed constraint of another variant that
+ is shared instead.
+ 
+ @since 1.1.0
+ */
+- (nonnull NSLayoutConstraint *) addConstraint:(nonnull NSLayoutConstraint *) constraint
+                                     toVariant:(nonnull NSString *) tag
+                                    targetView:(nullable UIView *) targetView
+                                          name:(nullable NSString *) name;
+
+/**
+ Deactivates the constraints of the current variant and activates those of
+ the variant `tag`, skipping the constraints both have in common.
+ 
+ @param tag The tag of the variant to switch to or `nil` to deactivate all
+ variant constraints.
+ 
+ @return The number of constraints that have been activated or deactivated.
+ 
+ @since 1.1.0
+ */
+- (NSUInteger) switchToVariant:(nullable NSString *) tag;
+
+@end
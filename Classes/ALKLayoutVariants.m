@@ -0,0 +1,236 @@
+//  ALKLayoutVariants.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <objc/runtime.h>
+
+#import "ALKLayoutVariants.h"
+#import "ALKLayoutRecorder.h"
+#import "UIView+ALKNamedConstraints.h"
+
+NSString * const kALKLayoutVariants = @"kALKLayoutVariants";
+
+/// A constraint of a variant and the name it is registered under while the
+/// variant is current.
+@interface ALKVariantConstraint : NSObject
+
+@property (nonatomic, strong, nonnull) NSLayoutConstraint * constraint;
+@property (nonatomic, weak, nullable) UIView * targetView;
+@property (nonatomic, copy, nullable) NSString * name;
+
+@end
+
+@implementation ALKVariantConstraint
+@end
+
+/// The constraints to deactivate and to activate when switching from one
+/// variant to another.
+@interface ALKVariantDelta : NSObject
+
+@property (nonatomic, strong, nonnull) NSArray<ALKVariantConstraint *> * removed;
+@property (nonatomic, strong, nonnull) NSArray<ALKVariantConstraint *> * added;
+@property (nonatomic, strong, nonnull) NSArray<NSLayoutConstraint *> * removedConstraints;
+@property (nonatomic, strong, nonnull) NSArray<NSLayoutConstraint *> * addedConstraints;
+
+@end
+
+@implementation ALKVariantDelta
+@end
+
+@interface ALKLayoutVariants ()
+
+@property (nonatomic, copy, readwrite, nullable) NSString * currentVariant;
+
+@end
+
+@implementation ALKLayoutVariants {
+    NSMutableArray<NSString *> *_variantTags;
+    NSMutableDictionary<NSString *, NSMutableArray<ALKVariantConstraint *> *> *_variants;
+    
+    // unnamed constraints of all variants, an equal declaration in another variant shares them
+    NSMutableArray<NSLayoutConstraint *> *_unnamedConstraints;
+    
+    // deltas keyed by @[from, to], dropped whenever a variant changes
+    NSMutableDictionary<NSArray *, ALKVariantDelta *> *_deltas;
+}
+
++ (nonnull instancetype) variantsOfView:(nonnull UIView *) view {
+    ALKLayoutVariants *variants = objc_getAssociatedObject(view, (__bridge const void *)(kALKLayoutVariants));
+    if (nil == variants) {
+        variants = [[ALKLayoutVariants alloc] init];
+        objc_setAssociatedObject(view, (__bridge const void *)(kALKLayoutVariants), variants, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return variants;
+}
+
+- (nonnull instancetype) init {
+    self = [super init];
+    if (self) {
+        _variantTags = [NSMutableArray array];
+        _variants = [NSMutableDictionary dictionary];
+        _unnamedConstraints = [NSMutableArray array];
+        _deltas = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (nonnull NSArray<NSString *> *) variantTags {
+    return [_variantTags copy];
+}
+
+- (NSUInteger) constraintCountOfVariant:(nonnull NSString *) tag {
+    return _variants[tag].count;
+}
+
+#pragma mark - Declaring
+
+- (nonnull NSLayoutConstraint *) addConstraint:(nonnull NSLayoutConstraint *) constraint
+                                     toVariant:(nonnull NSString *) tag
+                                    targetView:(nullable UIView *) targetView
+                                          name:(nullable NSString *) name {
+    NSMutableArray<ALKVariantConstraint *> *entries = _variants[tag];
+    if (nil == entries) {
+        entries = [NSMutableArray array];
+        _variants[tag] = entries;
+        [_variantTags addObject:tag];
+    }
+    
+    if (nil == name) {
+        NSLayoutConstraint *shared = equalConstraint(_unnamedConstraints, constraint);
+        if (shared) {
+            if (NSNotFound != indexOfConstraint(entries, shared)) return shared;
+            constraint = shared;
+        } else {
+            [_unnamedConstraints addObject:constraint];
+        }
+    }
+    
+    ALKVariantConstraint *entry = [[ALKVariantConstraint alloc] init];
+    entry.constraint = constraint;
+    entry.targetView = targetView;
+    entry.name = name;
+    [entries addObject:entry];
+    [_deltas removeAllObjects];
+    
+    // a declaration for the current variant takes effect right away
+    if ([tag isEqualToString:self.currentVariant]) {
+        constraint.active = YES;
+        [[ALKLayoutRecorder activeRecorder] recordConstraint:constraint];
+        if (name) {
+            [targetView alk_addConstraint:constraint withName:name];
+        }
+    }
+    
+    return constraint;
+}
+
+#pragma mark - Switching
+
+- (NSUInteger) switchToVariant:(nullable NSString *) tag {
+    NSString *current = self.currentVariant;
+    if (tag == current || [tag isEqualToString:current]) return 0;
+    
+    ALKVariantDelta *delta = [self deltaFrom:current to:tag];
+    ALKLayoutRecorder *recorder = [ALKLayoutRecorder activeRecorder];
+    
+    [NSLayoutConstraint deactivateConstraints:delta.removedConstraints];
+    [recorder recordDeactivationOfConstraints:delta.removedConstraints];
+    for (ALKVariantConstraint *entry in delta.removed) {
+        UIView *targetView = entry.targetView;
+        if (entry.name && [targetView alk_constraintWithName:entry.name] == entry.constraint) {
+            [targetView alk_removeConstraintWithName:entry.name];
+        }
+    }
+    
+    [NSLayoutConstraint activateConstraints:delta.addedConstraints];
+    [recorder recordActivationOfConstraints:delta.addedConstraints];
+    for (ALKVariantConstraint *entry in delta.added) {
+        if (entry.name) {
+            [entry.targetView alk_addConstraint:entry.constraint withName:entry.name];
+        }
+    }
+    
+    self.currentVariant = tag;
+    
+    return delta.removed.count + delta.added.count;
+}
+
+- (nonnull ALKVariantDelta *) deltaFrom:(nullable NSString *) from to:(nullable NSString *) to {
+    NSArray *key = @[ from ?: [NSNull null], to ?: [NSNull null] ];
+    ALKVariantDelta *delta = _deltas[key];
+    if (delta) return delta;
+    
+    NSArray<ALKVariantConstraint *> *fromEntries = from ? _variants[from] : nil;
+    NSArray<ALKVariantConstraint *> *toEntries = to ? _variants[to] : nil;
+    
+    delta = [[ALKVariantDelta alloc] init];
+    delta.removed = entriesMissingIn(fromEntries, toEntries);
+    delta.added = entriesMissingIn(toEntries, fromEntries);
+    delta.removedConstraints = [delta.removed valueForKey:@"constraint"];
+    delta.addedConstraints = [delta.added valueForKey:@"constraint"];
+    
+    _deltas[key] = delta;
+    return delta;
+}
+
+#pragma mark - Functions
+
+static NSArray<ALKVariantConstraint *> * _Nonnull entriesMissingIn(NSArray<ALKVariantConstraint *> * _Nullable entries,
+                                                                   NSArray<ALKVariantConstraint *> * _Nullable others) {
+    NSMutableSet<NSLayoutConstraint *> *otherConstraints = [NSMutableSet setWithCapacity:others.count];
+    for (ALKVariantConstraint *entry in others) {
+        [otherConstraints addObject:entry.constraint];
+    }
+    
+    NSMutableArray<ALKVariantConstraint *> *missing = [NSMutableArray array];
+    for (ALKVariantConstraint *entry in entries) {
+        if (![otherConstraints containsObject:entry.constraint]) {
+            [missing addObject:entry];
+        }
+    }
+    return missing;
+}
+
+static NSUInteger indexOfConstraint(NSArray<ALKVariantConstraint *> * _Nonnull entries, NSLayoutConstraint * _Nonnull constraint) {
+    return [entries indexOfObjectPassingTest:^BOOL(ALKVariantConstraint *entry, NSUInteger idx, BOOL *stop) {
+        return entry.constraint == constraint;
+    }];
+}
+
+static NSLayoutConstraint * _Nullable equalConstraint(NSArray<NSLayoutConstraint *> * _Nonnull constraints, NSLayoutConstraint * _Nonnull lc) {
+    for (NSLayoutConstraint *other in constraints) {
+        if (other.firstItem == lc.firstItem &&
+            other.secondItem == lc.secondItem &&
+            other.firstAttribute == lc.firstAttribute &&
+            other.secondAttribute == lc.secondAttribute &&
+            other.relation == lc.relation &&
+            other.multiplier == lc.multiplier &&
+            other.constant == lc.constant &&
+            other.priority == lc.priority) {
+            return other;
+        }
+    }
+    return nil;
+}
+
+@end
@@ -0,0 +1,114 @@
+//  ALKPrecomputedLayout.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+/**
+ The `ALKPrecomputedLayout` stores the solved frames of a view subtree for a
+ fixed set of container sizes, so screens whose layout only depends on the
+ size of their container can show their first frame without creating and
+ solving their constraints.
+ 
+ Solve the layout once for all supported sizes, e.g. in a test or a debug
+ build, and ship the data representation with the app:
+ 
+    ALKPrecomputedLayout *layout = [ALKPrecomputedLayout precomputedLayoutOfView:view sizes:@[
+      [NSValue valueWithCGSize:CGSizeMake(375.f, 667.f)],
+      [NSValue valueWithCGSize:CGSizeMake(414.f, 896.f)],
+    ]];
+    [layout.dataRepresentation writeToURL:url atomically:YES];
+ 
+ At runtime the stored frames are used if the size of the container matches
+ one of them, the constraints are only created otherwise:
+ 
+    ALKPrecomputedLayout *layout = [ALKPrecomputedLayout precomputedLayoutWithData:data];
+    if (![layout applyToView:self.view]) {
+      [self setupLayout];
+    }
+ 
+ Views are identified by their position in the subtree, so the subtree must be
+ built the same way as when the layout was precomputed. `-applyToView:` does
+ nothing if the number of views does not match. Frames are stored as
+ little-endian doubles and do not depend on the architecture they have been
+ solved on.
+ 
+ @since 1.1.0
+ */
+@interface ALKPrecomputedLayout : NSObject
+
+/**
+ Lays out the subviews of `view` for each of `sizes` and stores their frames.
+ The bounds of `view` are restored afterwards.
+ 
+ @param view The container, its constraints must not depend on its superview.
+ @param sizes The container sizes as `NSValue`s of `CGSize`.
+ 
+ @since 1.1.0
+ */
++ (nonnull instancetype) precomputedLayoutOfView:(nonnull UIView *) view
+                                           sizes:(nonnull NSArray<NSValue *> *) sizes;
+
+/**
+ Reads a layout from its data representation.
+ 
+ @return The layout or `nil` if `data` is not a valid representation.
+ 
+ @since 1.1.0
+ */
++ (nullable instancetype) precomputedLayoutWithData:(nonnull NSData *) data;
+
+/**
+ The layout as a binary property list.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, strong, readonly, nonnull) NSData * dataRepresentation;
+
+/**
+ The container sizes the layout has been solved for.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, strong, readonly, nonnull) NSArray<NSValue *> * sizes;
+
+/**
+ The number of subviews whose frames are stored per size.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger viewCount;
+
+/**
+ Sets the stored frames of the size that matches the bounds of `view`.
+ 
+ @param view The container, built like the one the layout has been solved for.
+ 
+ @return `YES` if the frames have been set, `NO` if there is no solution for
+ the size of `view` or its subtree does not match.
+ 
+ @since 1.1.0
+ */
+- (BOOL) applyToView:(nonnull UIView *) view;
+
+@end
@@ -0,0 +1,155 @@
+//  ALKPrecomputedLayout.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKPrecomputedLayout.h"
+#import "ALKViewTraversal.h"
+
+static NSString * const kALKPrecomputedLayoutVersion = @"version";
+static NSString * const kALKPrecomputedLayoutViewCount = @"viewCount";
+static NSString * const kALKPrecomputedLayoutSolutions = @"solutions";
+static NSString * const kALKPrecomputedLayoutWidth = @"width";
+static NSString * const kALKPrecomputedLayoutHeight = @"height";
+static NSString * const kALKPrecomputedLayoutFrames = @"frames";
+
+/// sizes closer than this are considered equal
+static const CGFloat kALKPrecomputedLayoutSizeTolerance = 0.01f;
+
+@interface ALKPrecomputedLayout ()
+
+@property (nonatomic, strong, readwrite, nonnull) NSArray<NSValue *> * sizes;
+@property (nonatomic, assign, readwrite) NSUInteger viewCount;
+
+@end
+
+@implementation ALKPrecomputedLayout {
+    /// per size, 4 little-endian doubles per view, depth first
+    NSArray<NSData *> *_frames;
+}
+
++ (nonnull instancetype) precomputedLayoutOfView:(nonnull UIView *) view
+                                           sizes:(nonnull NSArray<NSValue *> *) sizes {
+    NSArray<UIView *> *subviews = ALKSubviewsOfView(view);
+    NSMutableArray<NSData *> *frames = [NSMutableArray arrayWithCapacity:sizes.count];
+    
+    CGRect bounds = view.bounds;
+    for (NSValue *size in sizes) {
+        view.bounds = (CGRect){ bounds.origin, size.CGSizeValue };
+        [view setNeedsLayout];
+        [view layoutIfNeeded];
+        
+        NSMutableData *data = [NSMutableData dataWithLength:subviews.count * 4 * sizeof(NSSwappedDouble)];
+        NSSwappedDouble *values = data.mutableBytes;
+        for (NSUInteger i = 0; i < subviews.count; i++) {
+            CGRect frame = subviews[i].frame;
+            values[4 * i + 0] = NSSwapHostDoubleToLittle(frame.origin.x);
+            values[4 * i + 1] = NSSwapHostDoubleToLittle(frame.origin.y);
+            values[4 * i + 2] = NSSwapHostDoubleToLittle(frame.size.width);
+            values[4 * i + 3] = NSSwapHostDoubleToLittle(frame.size.height);
+        }
+        [frames addObject:data];
+    }
+    view.bounds = bounds;
+    [view setNeedsLayout];
+    [view layoutIfNeeded];
+    
+    ALKPrecomputedLayout *layout = [[ALKPrecomputedLayout alloc] init];
+    layout.sizes = [sizes copy];
+    layout.viewCount = subviews.count;
+    layout->_frames = frames;
+    return layout;
+}
+
++ (nullable instancetype) precomputedLayoutWithData:(nonnull NSData *) data {
+    NSDictionary *plist = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:NULL];
+    if (![plist isKindOfClass:[NSDictionary class]] || [plist[kALKPrecomputedLayoutVersion] integerValue] != 1) return nil;
+    
+    NSUInteger viewCount = [plist[kALKPrecomputedLayoutViewCount] unsignedIntegerValue];
+    NSArray *solutions = plist[kALKPrecomputedLayoutSolutions];
+    if (![solutions isKindOfClass:[NSArray class]]) return nil;
+    
+    NSMutableArray<NSValue *> *sizes = [NSMutableArray arrayWithCapacity:solutions.count];
+    NSMutableArray<NSData *> *frames = [NSMutableArray arrayWithCapacity:solutions.count];
+    for (NSDictionary *solution in solutions) {
+        if (![solution isKindOfClass:[NSDictionary class]]) return nil;
+        
+        NSData *solutionFrames = solution[kALKPrecomputedLayoutFrames];
+        if (![solutionFrames isKindOfClass:[NSData class]] || solutionFrames.length != viewCount * 4 * sizeof(NSSwappedDouble)) return nil;
+        
+        CGSize size = CGSizeMake([solution[kALKPrecomputedLayoutWidth] doubleValue], [solution[kALKPrecomputedLayoutHeight] doubleValue]);
+        [sizes addObject:[NSValue valueWithCGSize:size]];
+        [frames addObject:solutionFrames];
+    }
+    
+    ALKPrecomputedLayout *layout = [[ALKPrecomputedLayout alloc] init];
+    layout.sizes = sizes;
+    layout.viewCount = viewCount;
+    layout->_frames = frames;
+    return layout;
+}
+
+- (nonnull NSData *) dataRepresentation {
+    NSMutableArray *solutions = [NSMutableArray arrayWithCapacity:self.sizes.count];
+    [self.sizes enumerateObjectsUsingBlock:^(NSValue *size, NSUInteger idx, BOOL *stop) {
+        [solutions addObject:@{
+            kALKPrecomputedLayoutWidth: @(size.CGSizeValue.width),
+            kALKPrecomputedLayoutHeight: @(size.CGSizeValue.height),
+            kALKPrecomputedLayoutFrames: self->_frames[idx],
+        }];
+    }];
+    
+    NSDictionary *plist = @{
+        kALKPrecomputedLayoutVersion: @1,
+        kALKPrecomputedLayoutViewCount: @(self.viewCount),
+        kALKPrecomputedLayoutSolutions: solutions,
+    };
+    
+    return [NSPropertyListSerialization dataWithPropertyList:plist format:NSPropertyListBinaryFormat_v1_0 options:0 error:NULL];
+}
+
+#pragma mark - Applying
+
+- (BOOL) applyToView:(nonnull UIView *) view {
+    CGSize size = view.bounds.size;
+    NSUInteger index = [self.sizes indexOfObjectPassingTest:^BOOL(NSValue *value, NSUInteger idx, BOOL *stop) {
+        CGSize stored = value.CGSizeValue;
+        return fabs(stored.width - size.width) < kALKPrecomputedLayoutSizeTolerance &&
+               fabs(stored.height - size.height) < kALKPrecomputedLayoutSizeTolerance;
+    }];
+    if (NSNotFound == index) return NO;
+    
+    NSArray<UIView *> *subviews = ALKSubviewsOfView(view);
+    if (subviews.count != self.viewCount) return NO;
+    
+    const NSSwappedDouble *values = _frames[index].bytes;
+    for (NSUInteger i = 0; i < subviews.count; i++) {
+        subviews[i].frame = CGRectMake(NSSwapLittleDoubleToHost(values[4 * i + 0]),
+                                       NSSwapLittleDoubleToHost(values[4 * i + 1]),
+                                       NSSwapLittleDoubleToHost(values[4 * i + 2]),
+                                       NSSwapLittleDoubleToHost(values[4 * i + 3]));
+    }
+    
+    return YES;
+}
+
+@end
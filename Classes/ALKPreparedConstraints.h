@@ -0,0 +1,189 @@
+//  ALKPreparedConstraints.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+#import <AutoLayoutKit/ALKConstraintSpec.h>
+
+@class ALKPreparedConstraints;
+
+/**
+ @brief The block type of `+[ALKConstraints prepare:do:]`.
+ 
+ @param[in] c The ALKPreparedConstraints instance that records the declared
+ relations
+ 
+ @since 1.1.0
+ */
+typedef void (^LKPrepareBlock)(ALKPreparedConstraints * _Nonnull c);
+
+/**
+ `ALKPreparedConstraints` records the relations declared in a
+ `+[ALKConstraints prepare:do:]` block so that they can be applied later on the
+ main thread.
+ 
+ Declaring a relation neither creates a constraint nor touches the view
+ hierarchy, so an instance can be filled on any thread as long as it is not
+ shared with other threads while doing so. Constants are snapped to
+ `+[ALKConstraints constantResolution]` when they are declared.
+ 
+ The declaring methods mirror the ones of `ALKConstraints` but return nothing:
+ the constraints only exist once `-commit` has created them.
+ 
+ @since 1.1.0
+ */
+@interface ALKPreparedConstraints : NSObject
+
+/**
+ The view the relations are declared for.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, strong, readonly, nonnull) UIView * item;
+
+/**
+ `YES` once `-commit` has applied the declared relations.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly, getter=isCommitted) BOOL committed;
+
+/**
+ Creates an empty instance for `view`. `view` is not touched.
+ 
+ @since 1.1.0
+ */
+- (nonnull instancetype) initWithView:(nonnull UIView *) view;
+
+/**
+ Sets the priority of all upcoming relations, see
+ `-[ALKConstraints setPriority:]`.
+ 
+ @since 1.1.0
+ */
+- (void) setPriority:(UILayoutPriority) priority;
+
+/**
+ Shares all upcoming unnamed relations on commit, see
+ `-[ALKConstraints shareConstraints]`.
+ 
+ @since 1.1.0
+ */
+- (void) shareConstraints;
+
+/**
+ Declares `attribute` of the item to be equal to `constant`.
+ 
+ @since 1.1.0
+ */
+- (void) set:(ALKAttribute) attribute to:(CGFloat) constant;
+
+/**
+ Declares `attribute` of the item to be equal to `constant`. The named
+ constraint is registered on the item itself.
+ 
+ @since 1.1.0
+ */
+- (void) set:(ALKAttribute) attribute to:(CGFloat) constant name:(nullable NSString *) name;
+
+/**
+ Declares `attribute` of the item to be equal to `relatedAttribute` of
+ `relatedItem`.
+ 
+ @since 1.1.0
+ */
+- (void) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute;
+
+/**
+ Declares `attribute` of the item to be equal to `relatedAttribute` of
+ `relatedItem` plus `constant`.
+ 
+ @since 1.1.0
+ */
+- (void) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant;
+
+/**
+ Declares `attribute` of the item to be equal to `relatedAttribute` of
+ `relatedItem` plus `constant`. The named constraint is registered on the
+ superview of the item as it is at commit time.
+ 
+ @since 1.1.0
+ */
+- (void) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant name:(nullable NSString *) name;
+
+/**
+ Declares `attribute` of the item to be equal to `relatedAttribute` of
+ `relatedItem` times `multiplier` plus `constant`.
+ 
+ @param targetView The view that holds the constraint if it is named. If `nil`,
+ the superview of the item at commit time is used.
+ 
+ @since 1.1.0
+ */
+- (void) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nullable UIView *) targetView name:(nullable NSString *) name;
+
+/**
+ Declares `attribute` of the item to be less than or equal to
+ `relatedAttribute` of `relatedItem` times `multiplier` plus `constant`.
+ 
+ @param targetView The view that holds the constraint if it is named. If `nil`,
+ the superview of the item at commit time is used.
+ 
+ @since 1.1.0
+ */
+- (void) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nullable UIView *) targetView name:(nullable NSString *) name;
+
+/**
+ Declares `attribute` of the item to be greater than or equal to
+ `relatedAttribute` of `relatedItem` times `multiplier` plus `constant`.
+ 
+ @param targetView The view that holds the constraint if it is named. If `nil`,
+ the superview of the item at commit time is used.
+ 
+ @since 1.1.0
+ */
+- (void) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nullable UIView *) targetView name:(nullable NSString *) name;
+
+/**
+ Declares `attribute` of the item to be equal to `relatedAttribute` of the
+ safe area of `relatedItem`, see
+ `-[ALKConstraints make:equalToSafeArea:s:plus:name:]`. The safe area layout
+ guide is resolved on commit.
+ 
+ @since 1.1.0
+ */
+- (void) make:(ALKAttribute) attribute equalToSafeArea:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant name:(nullable NSString *) name;
+
+/**
+ Creates and applies the declared relations. This must be called on the main
+ thread and does nothing if the receiver has already been committed.
+ 
+ @return The created (or shared) constraints in the order they have been
+ declared, an empty array if there was nothing to commit.
+ 
+ @since 1.1.0
+ */
+- (nonnull NSArray<NSLayoutConstraint *> *) commit;
+
+@end
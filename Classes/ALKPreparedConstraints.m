@@ -0,0 +1,204 @@
+//  ALKPreparedConstraints.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKPreparedConstraints.h"
+#import "ALKConstraints.h"
+
+/// A relation declared by `ALKPreparedConstraints`. Only plain values are
+/// stored, the constraint itself is created on commit because
+/// `NSLayoutConstraint` must not be used off the main thread.
+@interface ALKPendingConstraint : NSObject
+
+@property (nonatomic, assign) ALKAttribute attribute;
+@property (nonatomic, assign) ALKRelation relation;
+@property (nonatomic, strong, nullable) id relatedItem;
+@property (nonatomic, assign) ALKAttribute relatedAttribute;
+@property (nonatomic, assign) CGFloat multiplier;
+@property (nonatomic, assign) CGFloat constant;
+@property (nonatomic, assign) UILayoutPriority priority;
+@property (nonatomic, weak, nullable) UIView * targetView;
+@property (nonatomic, copy, nullable) NSString * name;
+@property (nonatomic, assign) BOOL safeArea;
+@property (nonatomic, assign) BOOL shared;
+
+@end
+
+@implementation ALKPendingConstraint
+@end
+
+@interface ALKPreparedConstraints ()
+
+@property (nonatomic, strong, nonnull) UIView * item;
+@property (nonatomic, assign, getter=isCommitted) BOOL committed;
+@property (nonatomic, assign) UILayoutPriority priority;
+@property (nonatomic, assign) BOOL sharing;
+@property (nonatomic, strong, nonnull) NSMutableArray<ALKPendingConstraint *> * pendingConstraints;
+
+@end
+
+@implementation ALKPreparedConstraints
+
+- (nonnull instancetype) initWithView:(nonnull UIView *) view {
+    self = [super init];
+    if (self) {
+        // the view must not be touched until -commit runs on the main thread
+        self.item = view;
+        self.pendingConstraints = [NSMutableArray array];
+        
+        _priority = UILayoutPriorityRequired;
+    }
+    
+    return self;
+}
+
+#pragma mark - PRIORITY
+
+- (void) setPriority:(UILayoutPriority) priority {
+    _priority = priority;
+}
+
+#pragma mark - SHARING
+
+- (void) shareConstraints {
+    self.sharing = YES;
+}
+
+#pragma mark - DSL (SET)
+
+- (void) set:(ALKAttribute) attribute to:(CGFloat) constant {
+    declare(self, attribute, ALKEqualTo, nil, ALKNone, 1.f, constant, self.item, nil, NO);
+}
+
+- (void) set:(ALKAttribute) attribute to:(CGFloat) constant name:(nullable NSString *) name {
+    declare(self, attribute, ALKEqualTo, nil, ALKNone, 1.f, constant, self.item, name, NO);
+}
+
+#pragma mark - DSL (MAKE)
+
+- (void) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute {
+    declare(self, attribute, ALKEqualTo, relatedItem, relatedAttribute, 1.f, 0.f, nil, nil, NO);
+}
+
+- (void) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant {
+    declare(self, attribute, ALKEqualTo, relatedItem, relatedAttribute, 1.f, constant, nil, nil, NO);
+}
+
+- (void) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant name:(nullable NSString *) name {
+    declare(self, attribute, ALKEqualTo, relatedItem, relatedAttribute, 1.f, constant, nil, name, NO);
+}
+
+- (void) make:(ALKAttribute) attribute equalTo:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nullable UIView *) targetView name:(nullable NSString *) name {
+    declare(self, attribute, ALKEqualTo, relatedItem, relatedAttribute, multiplier, constant, targetView, name, NO);
+}
+
+- (void) make:(ALKAttribute) attribute lessThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nullable UIView *) targetView name:(nullable NSString *) name {
+    declare(self, attribute, ALKLessThan, relatedItem, relatedAttribute, multiplier, constant, targetView, name, NO);
+}
+
+- (void) make:(ALKAttribute) attribute greaterThan:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute times:(CGFloat) multiplier plus:(CGFloat) constant on:(nullable UIView *) targetView name:(nullable NSString *) name {
+    declare(self, attribute, ALKGreaterThan, relatedItem, relatedAttribute, multiplier, constant, targetView, name, NO);
+}
+
+- (void) make:(ALKAttribute) attribute equalToSafeArea:(nullable id) relatedItem s:(ALKAttribute) relatedAttribute plus:(CGFloat) constant name:(nullable NSString *) name {
+    declare(self, attribute, ALKEqualTo, relatedItem, relatedAttribute, 1.f, constant, nil, name, YES);
+}
+
+#pragma mark - COMMIT
+
+- (nonnull NSArray<NSLayoutConstraint *> *) commit {
+    NSAssert([NSThread isMainThread], @"ALKPreparedConstraints must be committed on the main thread");
+    
+    if (self.committed) return @[];
+    self.committed = YES;
+    
+    NSArray<ALKPendingConstraint *> *pendingConstraints = self.pendingConstraints;
+    self.pendingConstraints = [NSMutableArray array];
+    
+    NSMutableArray<NSLayoutConstraint *> *constraints = [NSMutableArray arrayWithCapacity:pendingConstraints.count];
+    
+    [ALKConstraints layout:self.item do:^(ALKConstraints *c) {
+        for (ALKPendingConstraint *pending in pendingConstraints) {
+            // sharing only ever gets switched on, so it applies from the first shared relation on
+            if (pending.shared) [c shareConstraints];
+            [c setPriority:pending.priority];
+            [constraints addObject:apply(c, pending)];
+        }
+    }];
+    
+    return constraints;
+}
+
+#pragma mark - Functions
+
+static void declare(ALKPreparedConstraints * _Nonnull prepared,
+                    ALKAttribute itemAttribute,
+                    ALKRelation relation,
+                    id _Nullable relatedItem,
+                    ALKAttribute relatedItemAttribute,
+                    CGFloat multiplier,
+                    CGFloat constant,
+                    UIView * _Nullable targetItem,
+                    NSString * _Nullable name,
+                    BOOL safeArea) {
+    NSCAssert(!prepared.committed, @"ALKPreparedConstraints cannot be changed after -commit");
+    
+    ALKPendingConstraint *pending = [[ALKPendingConstraint alloc] init];
+    pending.attribute = itemAttribute;
+    pending.relation = relation;
+    pending.relatedItem = relatedItem;
+    pending.relatedAttribute = relatedItemAttribute;
+    pending.multiplier = multiplier;
+    pending.constant = [ALKConstraints snappedConstant:constant];
+    pending.priority = prepared.priority;
+    pending.targetView = targetItem;
+    pending.name = name;
+    pending.safeArea = safeArea;
+    pending.shared = prepared.sharing;
+    [prepared.pendingConstraints addObject:pending];
+}
+
+static NSLayoutConstraint * _Nonnull apply(ALKConstraints * _Nonnull c, ALKPendingConstraint * _Nonnull pending) {
+    // the constant has already been snapped, snapping it again leaves it as it is
+    if (pending.safeArea) {
+        return [c make:pending.attribute equalToSafeArea:pending.relatedItem s:pending.relatedAttribute plus:pending.constant name:pending.name];
+    }
+    
+    UIView *targetView = pending.targetView;
+    switch (pending.relation) {
+        case ALKLessThan:
+            return targetView
+                ? [c make:pending.attribute lessThan:pending.relatedItem s:pending.relatedAttribute times:pending.multiplier plus:pending.constant on:targetView name:pending.name]
+                : [c make:pending.attribute lessThan:pending.relatedItem s:pending.relatedAttribute times:pending.multiplier plus:pending.constant name:pending.name];
+        case ALKGreaterThan:
+            return targetView
+                ? [c make:pending.attribute greaterThan:pending.relatedItem s:pending.relatedAttribute times:pending.multiplier plus:pending.constant on:targetView name:pending.name]
+                : [c make:pending.attribute greaterThan:pending.relatedItem s:pending.relatedAttribute times:pending.multiplier plus:pending.constant name:pending.name];
+        default:
+            return targetView
+                ? [c make:pending.attribute equalTo:pending.relatedItem s:pending.relatedAttribute times:pending.multiplier plus:pending.constant on:targetView name:pending.name]
+                : [c make:pending.attribute equalTo:pending.relatedItem s:pending.relatedAttribute times:pending.multiplier plus:pending.constant name:pending.name];
+    }
+}
+
+@end
@@ -0,0 +1,144 @@
+//  ALKTextMeasurementCache.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+/**
+ Measures a text for a constraining width, e.g. by calling `sizeThatFits:` of
+ a text view.
+ 
+ @since 1.1.0
+ */
+typedef CGSize (^ALKTextMeasureBlock)(CGFloat width);
+
+/**
+ The `ALKTextMeasurementCache` remembers the sizes of measured texts, so views
+ that derive their `intrinsicContentSize` from their text do not measure it
+ again while neither the text, its attributes nor the constraining width
+ changed.
+ 
+    - (CGSize)intrinsicContentSize
+    {
+      CGFloat width = self.bounds.size.width;
+      return [[ALKTextMeasurementCache sharedCache] sizeOfText:self.text attributes:self.font width:width measure:^CGSize(CGFloat width) {
+        return [self.label sizeThatFits:CGSizeMake(width, CGFLOAT_MAX)];
+      }];
+    }
+ 
+ Measurements are keyed by the text, an object identifying its attributes
+ (e.g. the font or an attributes dictionary) and the constraining width. A
+ text whose measured width at a wider constraining width already fits into a
+ narrower one breaks into the same lines there, so that measurement is reused
+ without measuring again. The least recently used texts are evicted once
+ `countLimit` is exceeded and the shared cache is emptied when the app
+ receives a memory warning.
+ 
+ The cache is not thread-safe and must only be used from the main thread.
+ 
+ @since 1.1.0
+ */
+@interface ALKTextMeasurementCache : NSObject
+
+/**
+ The cache that is shared by all views.
+ 
+ @since 1.1.0
+ */
++ (nonnull instancetype) sharedCache;
+
+/**
+ The maximum number of texts the cache keeps measurements of. Defaults to 512.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign) NSUInteger countLimit;
+
+/**
+ The number of texts the cache keeps measurements of.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ The number of requests answered from the cache, including `narrowedHitCount`.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger hitCount;
+
+/**
+ The number of requests answered with the measurement of a wider constraining
+ width.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger narrowedHitCount;
+
+/**
+ The number of requests that had to measure the text.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) NSUInteger missCount;
+
+/**
+ `hitCount` relative to all requests, or 0 if nothing has been requested yet.
+ 
+ @since 1.1.0
+ */
+@property (nonatomic, assign, readonly) double hitRate;
+
+/**
+ Returns the size of `text` for the constraining `width`, measured by
+ `measure` unless it is already known.
+ 
+ @param text The text to measure.
+ @param attributes Identifies everything besides the text and the width that
+ the size depends on, compared with `isEqual:`.
+ @param width The constraining width.
+ @param measure Measures the text, only called on a miss.
+ 
+ @since 1.1.0
+ */
+- (CGSize) sizeOfText:(nonnull NSString *) text
+           attributes:(nonnull id<NSCopying>) attributes
+                width:(CGFloat) width
+              measure:(nonnull ALKTextMeasureBlock) measure;
+
+/**
+ Resets `hitCount`, `narrowedHitCount` and `missCount`.
+ 
+ @since 1.1.0
+ */
+- (void) resetStatistics;
+
+/**
+ Drops all measurements.
+ 
+ @since 1.1.0
+ */
+- (void) removeAllMeasurements;
+
+@end
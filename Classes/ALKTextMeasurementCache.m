@@ -0,0 +1,254 @@
+//  ALKTextMeasurementCache.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTextMeasurementCache.h"
+
+/// measurements kept per text, the oldest is replaced first
+enum { ALKTextMeasurementSlotCount = 4 };
+
+/// A text and its attributes.
+@interface ALKTextMeasurementKey : NSObject <NSCopying>
+
+@property (nonatomic, copy, nonnull) NSString * text;
+@property (nonatomic, strong, nonnull) id<NSObject> attributes;
+@property (nonatomic, assign) NSUInteger textHash;
+
+@end
+
+@implementation ALKTextMeasurementKey
+
+- (NSUInteger) hash {
+    return self.textHash ^ (self.attributes.hash * 31);
+}
+
+- (BOOL) isEqual:(id) object {
+    if (self == object) return YES;
+    if (![object isKindOfClass:[ALKTextMeasurementKey class]]) return NO;
+    
+    ALKTextMeasurementKey *other = object;
+    return self.textHash == other.textHash &&
+           [self.attributes isEqual:other.attributes] &&
+           [self.text isEqualToString:other.text];
+}
+
+- (nonnull id) copyWithZone:(nullable NSZone *) zone {
+    // keys are never mutated once they are stored
+    return self;
+}
+
+@end
+
+/// The measurements of one text, linked in least recently used order.
+@interface ALKTextMeasurementNode : NSObject {
+    @public
+    CGFloat _widths[ALKTextMeasurementSlotCount];
+    CGSize _sizes[ALKTextMeasurementSlotCount];
+    NSUInteger _used;
+    NSUInteger _next;
+}
+
+@property (nonatomic, strong, nonnull) ALKTextMeasurementKey * key;
+@property (nonatomic, weak, nullable) ALKTextMeasurementNode * previous;
+@property (nonatomic, strong, nullable) ALKTextMeasurementNode * following;
+
+@end
+
+@implementation ALKTextMeasurementNode
+@end
+
+@interface ALKTextMeasurementCache ()
+
+@property (nonatomic, assign, readwrite) NSUInteger hitCount;
+@property (nonatomic, assign, readwrite) NSUInteger narrowedHitCount;
+@property (nonatomic, assign, readwrite) NSUInteger missCount;
+
+@end
+
+@implementation ALKTextMeasurementCache {
+    NSMutableDictionary<ALKTextMeasurementKey *, ALKTextMeasurementNode *> *_nodes;
+    
+    // most recently used first
+    ALKTextMeasurementNode *_head;
+    __weak ALKTextMeasurementNode *_tail;
+}
+
++ (nonnull instancetype) sharedCache {
+    static ALKTextMeasurementCache * sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[ALKTextMeasurementCache alloc] init];
+    });
+    return sharedCache;
+}
+
+- (nonnull instancetype) init {
+    self = [super init];
+    if (self) {
+        _nodes = [NSMutableDictionary dictionary];
+        _countLimit = 512;
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(removeAllMeasurements)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void) dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark - Statistics
+
+- (NSUInteger) count {
+    return _nodes.count;
+}
+
+- (double) hitRate {
+    NSUInteger total = self.hitCount + self.missCount;
+    return (total > 0) ? (double)self.hitCount / (double)total : 0.0;
+}
+
+- (void) resetStatistics {
+    self.hitCount = 0;
+    self.narrowedHitCount = 0;
+    self.missCount = 0;
+}
+
+#pragma mark - Measuring
+
+- (CGSize) sizeOfText:(nonnull NSString *) text
+           attributes:(nonnull id<NSCopying>) attributes
+                width:(CGFloat) width
+              measure:(nonnull ALKTextMeasureBlock) measure {
+    ALKTextMeasurementKey *key = [[ALKTextMeasurementKey alloc] init];
+    key.text = text;
+    key.attributes = (id<NSObject>)attributes;
+    key.textHash = text.hash;
+    
+    ALKTextMeasurementNode *node = _nodes[key];
+    if (node) {
+        [self moveToFront:node];
+        
+        CGSize size;
+        BOOL narrowed = NO;
+        if (findMeasurement(node, width, &size, &narrowed)) {
+            self.hitCount += 1;
+            if (narrowed) self.narrowedHitCount += 1;
+            return size;
+        }
+    } else {
+        // the attributes are only copied once they are stored
+        key.attributes = (id<NSObject>)[attributes copyWithZone:nil];
+        
+        node = [[ALKTextMeasurementNode alloc] init];
+        node.key = key;
+        _nodes[key] = node;
+        [self moveToFront:node];
+        [self evictIfNeeded];
+    }
+    
+    self.missCount += 1;
+    CGSize size = measure(width);
+    
+    NSUInteger slot = node->_next;
+    node->_widths[slot] = width;
+    node->_sizes[slot] = size;
+    node->_next = (slot + 1) % ALKTextMeasurementSlotCount;
+    node->_used = MIN(node->_used + 1, (NSUInteger)ALKTextMeasurementSlotCount);
+    
+    return size;
+}
+
+- (void) removeAllMeasurements {
+    [_nodes removeAllObjects];
+    
+    // unlink iteratively, releasing a long chain through -dealloc could overflow the stack
+    ALKTextMeasurementNode *node = _head;
+    _head = nil;
+    _tail = nil;
+    while (node) {
+        ALKTextMeasurementNode *following = node.following;
+        node.following = nil;
+        node = following;
+    }
+}
+
+#pragma mark - LRU
+
+- (void) moveToFront:(nonnull ALKTextMeasurementNode *) node {
+    if (_head == node) return;
+    
+    // unlink, the node is kept alive by the dictionary
+    ALKTextMeasurementNode *previous = node.previous;
+    ALKTextMeasurementNode *following = node.following;
+    previous.following = following;
+    following.previous = previous;
+    if (_tail == node) _tail = previous;
+    
+    node.previous = nil;
+    node.following = _head;
+    _head.previous = node;
+    _head = node;
+    if (nil == _tail) _tail = node;
+}
+
+- (void) evictIfNeeded {
+    while (_nodes.count > self.countLimit && _tail) {
+        ALKTextMeasurementNode *node = _tail;
+        ALKTextMeasurementNode *previous = node.previous;
+        
+        previous.following = nil;
+        _tail = previous;
+        if (_head == node) _head = nil;
+        
+        [_nodes removeObjectForKey:node.key];
+    }
+}
+
+#pragma mark - Functions
+
+static BOOL findMeasurement(ALKTextMeasurementNode * _Nonnull node, CGFloat width, CGSize * _Nonnull size, BOOL * _Nonnull narrowed) {
+    for (NSUInteger i = 0; i < node->_used; i++) {
+        if (node->_widths[i] == width) {
+            *size = node->_sizes[i];
+            *narrowed = NO;
+            return YES;
+        }
+    }
+    
+    // a text that needed at most `width` at a wider constraint breaks into the same lines
+    for (NSUInteger i = 0; i < node->_used; i++) {
+        if (node->_widths[i] > width && node->_sizes[i].width <= width) {
+            *size = node->_sizes[i];
+            *narrowed = YES;
+            return YES;
+        }
+    }
+    
+    return NO;
+}
+
+@end
@@ -25,5 +25,21 @@
 #import <UIKit/UIKit.h>
 
 #import <AutoLayoutKit/ALKConstraints.h>
+#import <AutoLayoutKit/ALKConstraintSpec.h>
 #import <AutoLayoutKit/ALKConstraints+Convenience.h>
+#import <AutoLayoutKit/ALKConstraintGraph.h>
+#import <AutoLayoutKit/ALKConflictExplainer.h>
+#import <AutoLayoutKit/ALKConstraintPool.h>
+#import <AutoLayoutKit/ALKConstraintRegistry.h>
+#import <AutoLayoutKit/ALKLayoutDSL.h>
+#import <AutoLayoutKit/ALKLayoutFlattener.h>
+#import <AutoLayoutKit/ALKLayoutPipeline.h>
+#import <AutoLayoutKit/ALKLayoutRecorder.h>
+#import <AutoLayoutKit/ALKLayoutSnapshot.h>
+#import <AutoLayoutKit/ALKLayoutTransition.h>
+#import <AutoLayoutKit/ALKLayoutVariants.h>
+#import <AutoLayoutKit/ALKPrecomputedLayout.h>
+#import <AutoLayoutKit/ALKPreparedConstraints.h>
+#import <AutoLayoutKit/ALKTextMeasurementCache.h>
 #import <AutoLayoutKit/UIView+ALKNamedConstraints.h>
+#import <AutoLayoutKit/UIView+ALKLayoutFootprint.h>
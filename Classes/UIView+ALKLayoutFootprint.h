@@ -0,0 +1,90 @@
+//  UIView+ALKLayoutFootprint.h
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+/**
+ The memory held by the layout layer, broken down by category. All sizes are
+ in bytes. Objects are measured with their allocation size; collections whose
+ storage is out of line are estimated from their number of entries.
+ 
+ @since 1.1.0
+ */
+typedef struct {
+  /** The number of measured views. */
+  NSUInteger views;
+  /** The number of measured constraints. */
+  NSUInteger constraints;
+  /** The `NSLayoutConstraint` objects. */
+  size_t constraintBytes;
+  /** The tables of named constraints, see `alk_namedConstraints`. */
+  size_t namedConstraintBytes;
+  /** Spare constraints and bookkeeping held by the `ALKConstraintPool`. */
+  size_t poolBytes;
+  /** The lookup table of the `ALKConstraintRegistry`. Only part of the
+   process-wide footprint as it is shared by all views. */
+  size_t registryBytes;
+} ALKLayoutFootprint;
+
+/**
+ The sum of all byte counts of `footprint`.
+ 
+ @since 1.1.0
+ */
+NS_INLINE size_t ALKLayoutFootprintTotal(ALKLayoutFootprint footprint) {
+  return footprint.constraintBytes + footprint.namedConstraintBytes + footprint.poolBytes + footprint.registryBytes;
+}
+
+/**
+ The `ALKLayoutFootprint` category measures the memory that the layout layer
+ holds, e.g. to enforce memory budgets in app extensions:
+ 
+    ALKLayoutFootprint footprint = [self.view alk_layoutFootprint];
+    NSLog(@"%zu bytes in %lu constraints", ALKLayoutFootprintTotal(footprint), (unsigned long)footprint.constraints);
+ 
+ The constraint solver of UIKit is private, so the memory it uses for the
+ measured constraints is not included.
+ 
+ @since 1.1.0
+ */
+@interface UIView (ALKLayoutFootprint)
+
+/**
+ Measures the receiver and all of its subviews: the constraints installed on
+ them, their named constraint tables and their pooled constraints.
+ 
+ @since 1.1.0
+ */
+- (ALKLayoutFootprint) alk_layoutFootprint;
+
+/**
+ Measures everything the layout layer holds in the process: every constraint
+ known to the `ALKConstraintRegistry` or the `ALKConstraintPool`, all named
+ constraint tables and the shared tables themselves.
+ 
+ @since 1.1.0
+ */
++ (ALKLayoutFootprint) alk_processLayoutFootprint;
+
+@end
@@ -0,0 +1,85 @@
+//  UIView+ALKLayoutFootprint.m
+//  AutoLayoutKit
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <malloc/malloc.h>
+#import <objc/runtime.h>
+
+#import "UIView+ALKLayoutFootprint.h"
+#import "ALKConstraintPool.h"
+#import "ALKConstraintRegistry.h"
+#import "UIView+ALKNamedConstraints.h"
+
+@implementation UIView (ALKLayoutFootprint)
+
+- (ALKLayoutFootprint) alk_layoutFootprint {
+    ALKLayoutFootprint footprint;
+    memset(&footprint, 0, sizeof(footprint));
+    
+    ALKConstraintPool *pool = [ALKConstraintPool sharedPool];
+    
+    // iterative to survive deep hierarchies
+    NSMutableArray<UIView *> *stack = [NSMutableArray arrayWithObject:self];
+    while (stack.count > 0) {
+        UIView *view = [stack lastObject];
+        [stack removeLastObject];
+        
+        footprint.views += 1;
+        for (NSLayoutConstraint *lc in view.constraints) {
+            footprint.constraints += 1;
+            footprint.constraintBytes += malloc_size((__bridge const void *)lc);
+        }
+        footprint.namedConstraintBytes += [view alk_namedConstraintsFootprint];
+        footprint.poolBytes += [pool memoryFootprintOfView:view];
+        
+        [stack addObjectsFromArray:view.subviews];
+    }
+    
+    return footprint;
+}
+
++ (ALKLayoutFootprint) alk_processLayoutFootprint {
+    ALKLayoutFootprint footprint;
+    memset(&footprint, 0, sizeof(footprint));
+    
+    ALKConstraintRegistry *registry = [ALKConstraintRegistry sharedRegistry];
+    ALKConstraintPool *pool = [ALKConstraintPool sharedPool];
+    
+    // most constraints are only reachable weakly, so they are counted at the size of a plain instance
+    size_t constraintSize = malloc_good_size(class_getInstanceSize([NSLayoutConstraint class]));
+    footprint.constraints = registry.constraintCount + pool.constraintCount;
+    footprint.constraintBytes = footprint.constraints * constraintSize;
+    
+    NSArray<UIView *> *owners = [UIView alk_viewsWithNamedConstraints];
+    footprint.views = owners.count;
+    for (UIView *view in owners) {
+        footprint.namedConstraintBytes += [view alk_namedConstraintsFootprint];
+    }
+    
+    footprint.poolBytes = pool.memoryFootprint;
+    footprint.registryBytes = registry.memoryFootprint;
+    
+    return footprint;
+}
+
+@end
@@ -41,6 +41,15 @@
  */
 @property (nonatomic, strong, nonnull, setter = alk_setNamedConstraints:) NSMutableDictionary * alk_namedConstraints;
 
+/**
+ The named constraints of the receiver or `nil` if it has none. Unlike
+ `alk_namedConstraints`, this never creates a table, so inspecting a hierarchy
+ does not register its views with `alk_viewsWithNamedConstraints`.
+ 
+ @since 1.1.0
+ */
+- (nullable NSDictionary<NSString *, NSLayoutConstraint *> *) alk_existingNamedConstraints;
+
 /** 
  Tries to add a constraint to the `UIView` while remembering the 
  `constraint_name` for future reference.
@@ -96,4 +105,73 @@
  */
 - (void) alk_removeConstraintWithName:(nullable NSString *) name;
 
+/**
+ Changes the constant of the constraint named `name`. Unlike assigning the
+ constant directly, this change is seen by the `ALKLayoutRecorder`.
+ 
+ @param constant The new constant.
+ @param name The name of an `NSLayoutConstraint` that has been added to the
+ receiver before, using `alk_addConstraint:withName:`.
+ 
+ @return The changed constraint or `nil` if the name is not used for a
+ constraint.
+ 
+ @since 1.1.0
+ */
+- (nullable NSLayoutConstraint *) alk_setConstant:(CGFloat) constant
+                            forConstraintWithName:(nullable NSString *) name;
+
+/**
+ Changes the constants of several named constraints in one batch.
+ 
+ Only constants are changed, so the layout engine keeps the structure of the
+ layout and re-solves from its previous solution on the next layout pass.
+ Prefer this over removing and re-adding constraints when the container size
+ changes (rotation, split view, keyboard). Constants that already have the
+ requested value are left alone.
+ 
+ @param constants The new constants by constraint name. Names that are not
+ used for a constraint are ignored.
+ 
+ @return The number of constraints whose constant has changed.
+ 
+ @see -alk_setConstant:forConstraintWithName:
+ 
+ @since 1.1.0
+ */
+- (NSUInteger) alk_setConstants:(nonnull NSDictionary<NSString *, NSNumber *> *) constants;
+
+/**
+ Removes all named constraints whose items have been deallocated. Items that
+ are only detached from the view hierarchy keep their names, so a view that is
+ moved to another superview can be constrained by name again.
+ 
+ The receiver only tracks weak references to the items of its named
+ constraints, so this does not keep any views alive. Compaction also runs
+ automatically while constraints are added, so calling this is only needed
+ to release memory right away.
+ 
+ @return The number of named constraints that have been removed.
+ 
+ @see -alk_removeConstraintWithName:
+ 
+ @since 1.1.0
+ */
+- (NSUInteger) alk_compactNamedConstraints;
+
+/**
+ The number of bytes held by the named constraint tables of the receiver, not
+ counting the constraints themselves.
+ 
+ @since 1.1.0
+ */
+- (size_t) alk_namedConstraintsFootprint;
+
+/**
+ All views that currently have named constraint tables.
+ 
+ @since 1.1.0
+ */
++ (nonnull NSArray<UIView *> *) alk_viewsWithNamedConstraints;
+
 @end
@@ -23,11 +23,20 @@
 //  THE SOFTWARE.
 
 
+#import <malloc/malloc.h>
 #import <objc/runtime.h>
 
 #import "UIView+ALKNamedConstraints.h"
+#import "ALKConstraints.h"
+#import "ALKConstraintRegistry.h"
+#import "ALKLayoutRecorder.h"
 
 NSString * const kALKNamedConstraints = @"kALKNamedConstraints";
+NSString * const kALKNamedConstraintItems = @"kALKNamedConstraintItems";
+NSString * const kALKNamedConstraintsInsertions = @"kALKNamedConstraintsInsertions";
+
+/// the registry is compacted at the latest after this many insertions
+static NSUInteger const kALKNamedConstraintsMinimumCompactionInterval = 16;
 
 @implementation UIView (ALKNamedConstraints)
 
@@ -42,8 +51,12 @@ NSString * const kALKNamedConstraints = @"kALKNamedConstraints";
     NSLayoutConstraint *oldConstraint = namedConstraints[name];
     
     if (nil == oldConstraint) {
+        [self alk_compactNamedConstraintsIfNeeded];
+        
         namedConstraints[name] = constraint;
+        [self alk_namedConstraintItems][name] = weakItems(constraint);
         constraint.active = YES;
+        [[ALKLayoutRecorder activeRecorder] recordConstraint:constraint addedTo:self withName:name];
         return constraint;
     } else {
         NSLog(@"Layout Constraint with name \"%@\" already exists", name);
@@ -77,15 +90,154 @@ NSString * const kALKNamedConstraints = @"kALKNamedConstraints";
     NSLayoutConstraint *constraint = [self alk_constraintWithName:name];
     
     if (nil != constraint) {
-        constraint.active = NO;
-        [self.alk_namedConstraints removeObjectForKey:name];
+        [self alk_releaseConstraint:constraint withName:name];
+        [[ALKLayoutRecorder activeRecorder] recordRemovalFrom:self withName:name];
+    }
+}
+
+- (nullable NSLayoutConstraint *) alk_setConstant:(CGFloat) constant forConstraintWithName:(nullable NSString *) name {
+    NSLayoutConstraint *constraint = [self alk_constraintWithName:name];
+    
+    if (nil != constraint) {
+        constant = [ALKConstraints snappedConstant:constant];
+        constraint.constant = constant;
+        [[ALKLayoutRecorder activeRecorder] recordConstant:constant on:self withName:name];
+    }
+    
+    return constraint;
+}
+
+- (NSUInteger) alk_setConstants:(nonnull NSDictionary<NSString *, NSNumber *> *) constants {
+    NSDictionary *namedConstraints = self.alk_namedConstraints;
+    ALKLayoutRecorder *recorder = [ALKLayoutRecorder activeRecorder];
+    __block NSUInteger changed = 0;
+    
+    [constants enumerateKeysAndObjectsUsingBlock:^(NSString *name, NSNumber *value, BOOL *stop) {
+        NSLayoutConstraint *constraint = namedConstraints[name];
+        CGFloat constant = [ALKConstraints snappedConstant:(CGFloat)value.doubleValue];
+        
+        // every write invalidates the layout, even an unchanged one
+        if (nil == constraint || constraint.constant == constant) return;
+        
+        constraint.constant = constant;
+        [recorder recordConstant:constant on:self withName:name];
+        changed++;
+    }];
+    
+    return changed;
+}
+
+- (NSUInteger) alk_compactNamedConstraints {
+    NSMutableDictionary *namedItems = [self alk_namedConstraintItems];
+    NSMutableArray *deadNames = nil;
+    
+    for (NSString *name in namedItems) {
+        NSLayoutConstraint *constraint = self.alk_namedConstraints[name];
+        if (nil == constraint || !itemsAreAlive(namedItems[name])) {
+            if (nil == deadNames) deadNames = [NSMutableArray array];
+            [deadNames addObject:name];
+        }
+    }
+    
+    for (NSString *name in deadNames) {
+        NSLayoutConstraint *constraint = self.alk_namedConstraints[name];
+        if (nil != constraint) {
+            [self alk_releaseConstraint:constraint withName:name];
+        } else {
+            [namedItems removeObjectForKey:name];
+        }
+    }
+    
+    objc_setAssociatedObject(self, (__bridge const void *)(kALKNamedConstraintsInsertions), nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    
+    return deadNames.count;
+}
+
+- (size_t) alk_namedConstraintsFootprint {
+    NSDictionary *namedConstraints = objc_getAssociatedObject(self, (__bridge const void *)(kALKNamedConstraints));
+    NSDictionary *namedItems = objc_getAssociatedObject(self, (__bridge const void *)(kALKNamedConstraintItems));
+    
+    // dictionaries keep their storage out of line, estimate it with two words per entry
+    size_t bytes = malloc_size((__bridge const void *)namedConstraints) + namedConstraints.count * 2 * sizeof(void *);
+    for (NSString *name in namedConstraints) {
+        bytes += malloc_size((__bridge const void *)name);
+    }
+    
+    bytes += malloc_size((__bridge const void *)namedItems) + namedItems.count * 2 * sizeof(void *);
+    for (NSPointerArray *items in [namedItems objectEnumerator]) {
+        bytes += malloc_size((__bridge const void *)items) + items.count * sizeof(void *);
+    }
+    
+    return bytes;
+}
+
++ (nonnull NSArray<UIView *> *) alk_viewsWithNamedConstraints {
+    return [namedConstraintOwners() allObjects];
+}
+
+#pragma mark - Private API
+
+- (void) alk_releaseConstraint:(nonnull NSLayoutConstraint *) constraint withName:(nonnull NSString *) name {
+    // named constraints are never shared through the registry, so nobody else uses it
+    constraint.active = NO;
+    [self.alk_namedConstraints removeObjectForKey:name];
+    [[self alk_namedConstraintItems] removeObjectForKey:name];
+}
+
+- (void) alk_compactNamedConstraintsIfNeeded {
+    NSNumber *insertions = objc_getAssociatedObject(self, (__bridge const void *)(kALKNamedConstraintsInsertions));
+    NSUInteger count = insertions.unsignedIntegerValue + 1;
+    
+    // compacting once the insertions exceed the registry size keeps adding amortized O(1)
+    if (count >= MAX(kALKNamedConstraintsMinimumCompactionInterval, self.alk_namedConstraints.count)) {
+        [self alk_compactNamedConstraints];
+    } else {
+        objc_setAssociatedObject(self, (__bridge const void *)(kALKNamedConstraintsInsertions), @(count), OBJC_ASSOCIATION_RETAIN_NONATOMIC);
     }
 }
 
+- (nonnull NSMutableDictionary<NSString *, NSPointerArray *> *) alk_namedConstraintItems {
+    NSMutableDictionary *namedItems = objc_getAssociatedObject(self, (__bridge const void *)(kALKNamedConstraintItems));
+    
+    if (nil == namedItems) {
+        namedItems = [NSMutableDictionary dictionary];
+        objc_setAssociatedObject(self, (__bridge const void *)(kALKNamedConstraintItems), namedItems, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    
+    return namedItems;
+}
+
+#pragma mark - Functions
+
+static NSHashTable<UIView *> * _Nonnull namedConstraintOwners(void) {
+    static NSHashTable *owners = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        owners = [NSHashTable weakObjectsHashTable];
+    });
+    return owners;
+}
+
+static NSPointerArray * _Nonnull weakItems(NSLayoutConstraint * _Nonnull constraint) {
+    NSPointerArray *items = [NSPointerArray weakObjectsPointerArray];
+    if (constraint.firstItem) [items addPointer:(__bridge void *)constraint.firstItem];
+    if (constraint.secondItem) [items addPointer:(__bridge void *)constraint.secondItem];
+    return items;
+}
+
+static BOOL itemsAreAlive(NSPointerArray * _Nonnull items) {
+    // a detached item may only be re-parented, only a deallocated one is gone for good
+    for (NSUInteger i = 0; i < items.count; i++) {
+        if (NULL == [items pointerAtIndex:i]) return NO;
+    }
+    return YES;
+}
+
 #pragma mark - Getter & Setter LK_namedConstraints
 
 - (void) alk_setNamedConstraints:(nonnull NSMutableDictionary *) namedConstraintsDict {
 	objc_setAssociatedObject(self, (__bridge const void *)(kALKNamedConstraints), namedConstraintsDict, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+	[namedConstraintOwners() addObject:self];
 }
 
 - (nonnull NSMutableDictionary *) alk_namedConstraints {
@@ -106,4 +258,9 @@ NSString * const kALKNamedConstraints = @"kALKNamedConstraints";
 	return namedConstraints;
 }
 
+- (nullable NSDictionary<NSString *, NSLayoutConstraint *> *) alk_existingNamedConstraints {
+    NSDictionary *namedConstraints = objc_getAssociatedObject(self, (__bridge const void *)(kALKNamedConstraints));
+    return [namedConstraints isKindOfClass:[NSMutableDictionary class]] ? namedConstraints : nil;
+}
+
 @end
@@ -0,0 +1,85 @@
+//  ALKBenchmark.h
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+/// The synthetic layouts the benchmark suite can generate.
+typedef NS_ENUM(NSUInteger, ALKBenchmarkShape) {
+  /// views stacked below each other
+  ALKBenchmarkShapeChain,
+  /// views nested into each other, each inset from its parent
+  ALKBenchmarkShapeDeepTree,
+  /// views next to each other with equal widths
+  ALKBenchmarkShapeWideRow,
+  /// a square grid of cells sized relative to the container
+  ALKBenchmarkShapeGrid
+};
+
+/// Name of the named constraint every generated view gets, used for edits.
+FOUNDATION_EXTERN NSString * const kALKBenchmarkEditableConstraint;
+
+/**
+ Generates layouts, runs them repeatedly and collects the timings into a JSON
+ report. Every result is a dictionary with `name`, `kind`, `count`,
+ `iterations`, `p50`, `p95`, `p99`, `max` and `mean` (all times in
+ milliseconds) plus `constraints` and `bytes` where they apply. Construction
+ results also carry `allocations` and `allocatedBytes`: the malloc blocks and
+ bytes a constructed layout keeps alive, averaged over the iterations.
+ */
+@interface ALKBenchmark : NSObject
+
++ (NSString *)nameOfShape:(ALKBenchmarkShape)shape;
+
+/// Creates a container with `count` constrained views of the given shape.
++ (UIView *)layoutWithShape:(ALKBenchmarkShape)shape count:(NSUInteger)count;
+
+/// Creates one layout per iteration and measures the declaration of its constraints.
++ (NSDictionary *)measureConstructionOfShape:(ALKBenchmarkShape)shape count:(NSUInteger)count iterations:(NSUInteger)iterations;
+
+/// Lays `root` out for every container size in turn, changing the constants of
+/// `edits` named constraints before each pass.
++ (NSDictionary *)measureLayoutOfRoot:(UIView *)root
+                                 name:(NSString *)name
+                       containerSizes:(NSArray<NSValue *> *)containerSizes
+                                edits:(NSUInteger)edits
+                           iterations:(NSUInteger)iterations;
+
+/// Looks up every named constraint of the subtree of `root` once per iteration.
++ (NSDictionary *)measureNamedLookupsOfRoot:(UIView *)root name:(NSString *)name iterations:(NSUInteger)iterations;
+
+/// Looks up `count` registered constraints in a fresh `ALKConstraintRegistry`
+/// once per iteration, ten constraints per view.
++ (NSDictionary *)measureRegistryLookupsOfCount:(NSUInteger)count iterations:(NSUInteger)iterations;
+
+/// Replays a stream recorded with `ALKLayoutRecorder` once per iteration.
++ (NSDictionary *)measureReplayOfRecording:(NSData *)recording name:(NSString *)name iterations:(NSUInteger)iterations;
+
+/// p50, p95, p99, max and mean of `samples` (in seconds), converted to milliseconds.
++ (NSDictionary *)statisticsOfSamples:(NSArray<NSNumber *> *)samples;
+
+/// The JSON report of `results`, including the current and the peak memory
+/// footprint of the process.
++ (NSData *)reportWithResults:(NSArray<NSDictionary *> *)results;
+
+@end
@@ -0,0 +1,379 @@
+//  ALKBenchmark.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <QuartzCore/QuartzCore.h>
+#import <mach/mach.h>
+#import <malloc/malloc.h>
+
+#import "ALKBenchmark.h"
+#import "AutoLayoutKit.h"
+
+NSString * const kALKBenchmarkEditableConstraint = @"ALKBenchmarkEditableConstraint";
+
+static CGFloat const kALKBenchmarkCellSize = 8.f;
+
+@implementation ALKBenchmark
+
++ (NSString *)nameOfShape:(ALKBenchmarkShape)shape
+{
+  switch (shape) {
+    case ALKBenchmarkShapeChain:    return @"chain";
+    case ALKBenchmarkShapeDeepTree: return @"deep-tree";
+    case ALKBenchmarkShapeWideRow:  return @"wide-row";
+    case ALKBenchmarkShapeGrid:     return @"grid";
+  }
+  return @"unknown";
+}
+
+#pragma mark - Generators
+
++ (UIView *)layoutWithShape:(ALKBenchmarkShape)shape count:(NSUInteger)count
+{
+  UIView *root = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 1024.f, 1024.f)];
+  
+  switch (shape) {
+    case ALKBenchmarkShapeChain:
+      [self addChainOfCount:count toRoot:root];
+      break;
+    case ALKBenchmarkShapeDeepTree:
+      [self addTreeOfDepth:count toRoot:root];
+      break;
+    case ALKBenchmarkShapeWideRow:
+      [self addRowOfCount:count toRoot:root];
+      break;
+    case ALKBenchmarkShapeGrid:
+      [self addGridOfCount:count toRoot:root];
+      break;
+  }
+  
+  return root;
+}
+
++ (void)addChainOfCount:(NSUInteger)count toRoot:(UIView *)root
+{
+  UIView *previous = nil;
+  for (NSUInteger i = 0; i < count; i++) {
+    UIView *view = [[UIView alloc] initWithFrame:CGRectZero];
+    [root addSubview:view];
+    
+    UIView *above = previous;
+    [ALKConstraints layout:view do:^(ALKConstraints *c) {
+      [c make:ALKLeft equalTo:root s:ALKLeft];
+      [c make:ALKRight equalTo:root s:ALKRight];
+      [c make:ALKTop equalTo:(above ?: root) s:(above ? ALKBottom : ALKTop)];
+      [c set:ALKHeight to:kALKBenchmarkCellSize name:kALKBenchmarkEditableConstraint];
+    }];
+    previous = view;
+  }
+}
+
++ (void)addTreeOfDepth:(NSUInteger)depth toRoot:(UIView *)root
+{
+  UIView *parent = root;
+  for (NSUInteger i = 0; i < depth; i++) {
+    UIView *view = [[UIView alloc] initWithFrame:CGRectZero];
+    [parent addSubview:view];
+    
+    UIView *container = parent;
+    [ALKConstraints layout:view do:^(ALKConstraints *c) {
+      [c make:ALKTop equalTo:container s:ALKTop plus:1.f name:kALKBenchmarkEditableConstraint];
+      [c make:ALKLeft equalTo:container s:ALKLeft plus:1.f];
+      [c make:ALKBottom equalTo:container s:ALKBottom minus:1.f];
+      [c make:ALKRight equalTo:container s:ALKRight minus:1.f];
+    }];
+    parent = view;
+  }
+}
+
++ (void)addRowOfCount:(NSUInteger)count toRoot:(UIView *)root
+{
+  UIView *first = nil;
+  UIView *previous = nil;
+  for (NSUInteger i = 0; i < count; i++) {
+    UIView *view = [[UIView alloc] initWithFrame:CGRectZero];
+    [root addSubview:view];
+    
+    UIView *left = previous;
+    UIView *equal = first;
+    BOOL isLast = (i + 1 == count);
+    [ALKConstraints layout:view do:^(ALKConstraints *c) {
+      [c make:ALKLeading equalTo:(left ?: root) s:(left ? ALKTrailing : ALKLeading)];
+      [c make:ALKTop equalTo:root s:ALKTop];
+      [c set:ALKHeight to:kALKBenchmarkCellSize name:kALKBenchmarkEditableConstraint];
+      if (equal) [c make:ALKWidth equalTo:equal s:ALKWidth];
+      if (isLast) [c make:ALKTrailing equalTo:root s:ALKTrailing];
+    }];
+    
+    if (nil == first) first = view;
+    previous = view;
+  }
+}
+
++ (void)addGridOfCount:(NSUInteger)count toRoot:(UIView *)root
+{
+  NSUInteger columns = MAX((NSUInteger)1, (NSUInteger)ceil(sqrt((double)count)));
+  NSMutableArray<UIView *> *cells = [NSMutableArray arrayWithCapacity:count];
+  
+  for (NSUInteger i = 0; i < count; i++) {
+    UIView *view = [[UIView alloc] initWithFrame:CGRectZero];
+    [root addSubview:view];
+    
+    UIView *left = (i % columns == 0) ? nil : cells[i - 1];
+    UIView *above = (i < columns) ? nil : cells[i - columns];
+    [ALKConstraints layout:view do:^(ALKConstraints *c) {
+      [c make:ALKLeft equalTo:(left ?: root) s:(left ? ALKRight : ALKLeft)];
+      [c make:ALKTop equalTo:(above ?: root) s:(above ? ALKBottom : ALKTop)];
+      [c make:ALKWidth equalTo:root s:ALKWidth times:1.f / (CGFloat)columns];
+      [c set:ALKHeight to:kALKBenchmarkCellSize name:kALKBenchmarkEditableConstraint];
+    }];
+    [cells addObject:view];
+  }
+}
+
+#pragma mark - Measurements
+
++ (NSDictionary *)measureConstructionOfShape:(ALKBenchmarkShape)shape count:(NSUInteger)count iterations:(NSUInteger)iterations
+{
+  NSMutableArray *samples = [NSMutableArray arrayWithCapacity:iterations];
+  int64_t allocations = 0;
+  int64_t allocatedBytes = 0;
+  
+  for (NSUInteger i = 0; i < iterations; i++) {
+    @autoreleasepool {
+      malloc_statistics_t before;
+      malloc_zone_statistics(NULL, &before);
+      
+      CFTimeInterval start = CACurrentMediaTime();
+      UIView *root = [self layoutWithShape:shape count:count];
+      [samples addObject:@(CACurrentMediaTime() - start)];
+      
+      // read while the layout is alive, so this is what it keeps allocated
+      malloc_statistics_t after;
+      malloc_zone_statistics(NULL, &after);
+      allocations += (int64_t)after.blocks_in_use - (int64_t)before.blocks_in_use;
+      allocatedBytes += (int64_t)after.size_in_use - (int64_t)before.size_in_use;
+      (void)root;
+    }
+  }
+  
+  NSMutableDictionary *result = [[self resultNamed:[NSString stringWithFormat:@"%@-%lu", [self nameOfShape:shape], (unsigned long)count]
+                                              kind:@"construct"
+                                             count:count
+                                           samples:samples
+                                              root:nil] mutableCopy];
+  if (iterations > 0) {
+    result[@"allocations"] = @(allocations / (int64_t)iterations);
+    result[@"allocatedBytes"] = @(allocatedBytes / (int64_t)iterations);
+  }
+  return result;
+}
+
++ (NSDictionary *)measureLayoutOfRoot:(UIView *)root
+                                 name:(NSString *)name
+                       containerSizes:(NSArray<NSValue *> *)containerSizes
+                                edits:(NSUInteger)edits
+                           iterations:(NSUInteger)iterations
+{
+  NSArray<UIView *> *editable = [self viewsWithEditableConstraintIn:root];
+  NSMutableArray *samples = [NSMutableArray arrayWithCapacity:iterations];
+  
+  [root layoutIfNeeded];
+  
+  for (NSUInteger i = 0; i < iterations; i++) {
+    CGSize size = [containerSizes[i % containerSizes.count] CGSizeValue];
+    root.frame = CGRectMake(0.f, 0.f, size.width, size.height);
+    
+    // alternate the constants so that every pass has something to solve
+    for (NSUInteger e = 0; e < MIN(edits, editable.count); e++) {
+      UIView *view = editable[(i * edits + e) % editable.count];
+      NSLayoutConstraint *lc = [view alk_constraintWithName:kALKBenchmarkEditableConstraint];
+      [view alk_setConstant:(lc.constant == 1.f ? 2.f : 1.f) forConstraintWithName:kALKBenchmarkEditableConstraint];
+    }
+    
+    CFTimeInterval start = CACurrentMediaTime();
+    [root layoutIfNeeded];
+    [samples addObject:@(CACurrentMediaTime() - start)];
+  }
+  
+  return [self resultNamed:name kind:@"layout" count:root.subviews.count samples:samples root:root];
+}
+
++ (NSDictionary *)measureNamedLookupsOfRoot:(UIView *)root name:(NSString *)name iterations:(NSUInteger)iterations
+{
+  NSArray<UIView *> *editable = [self viewsWithEditableConstraintIn:root];
+  NSMutableArray *samples = [NSMutableArray arrayWithCapacity:iterations];
+  
+  for (NSUInteger i = 0; i < iterations; i++) {
+    CFTimeInterval start = CACurrentMediaTime();
+    for (UIView *view in editable) {
+      [view alk_constraintWithName:kALKBenchmarkEditableConstraint];
+    }
+    [samples addObject:@(CACurrentMediaTime() - start)];
+  }
+  
+  return [self resultNamed:name kind:@"lookup" count:editable.count samples:samples root:root];
+}
+
++ (NSDictionary *)measureRegistryLookupsOfCount:(NSUInteger)count iterations:(NSUInteger)iterations
+{
+  ALKConstraintRegistry *registry = [[ALKConstraintRegistry alloc] init];
+  NSMutableArray<UIView *> *views = [NSMutableArray arrayWithCapacity:count / 10 + 1];
+  NSMutableArray<NSLayoutConstraint *> *constraints = [NSMutableArray arrayWithCapacity:count];
+  
+  for (NSUInteger i = 0; i < count; i++) {
+    if (i % 10 == 0) [views addObject:[[UIView alloc] initWithFrame:CGRectZero]];
+    // minimum widths, so that the ten constraints of a view can be active together
+    NSLayoutConstraint *lc = [NSLayoutConstraint constraintWithItem:[views lastObject] attribute:NSLayoutAttributeWidth relatedBy:NSLayoutRelationGreaterThanOrEqual toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.f constant:(CGFloat)(i % 10)];
+    [constraints addObject:lc];
+  }
+  
+  // only active constraints are found, so every lookup below is a hit
+  [NSLayoutConstraint activateConstraints:constraints];
+  for (NSLayoutConstraint *lc in constraints) {
+    [registry registerConstraint:lc];
+  }
+  
+  NSMutableArray *samples = [NSMutableArray arrayWithCapacity:iterations];
+  for (NSUInteger i = 0; i < iterations; i++) {
+    CFTimeInterval start = CACurrentMediaTime();
+    for (NSUInteger j = 0; j < count; j++) {
+      [registry constraintWithItem:views[j / 10] attribute:ALKWidth relatedBy:ALKGreaterThan toItem:nil attribute:ALKNone multiplier:1.f constant:(CGFloat)(j % 10) priority:UILayoutPriorityRequired];
+    }
+    [samples addObject:@(CACurrentMediaTime() - start)];
+  }
+  
+  [NSLayoutConstraint deactivateConstraints:constraints];
+  
+  return [self resultNamed:[NSString stringWithFormat:@"registry-%lu", (unsigned long)count] kind:@"lookup" count:count samples:samples root:nil];
+}
+
++ (NSDictionary *)measureReplayOfRecording:(NSData *)recording name:(NSString *)name iterations:(NSUInteger)iterations
+{
+  NSMutableArray *samples = [NSMutableArray arrayWithCapacity:iterations];
+  NSUInteger constraints = 0;
+  
+  for (NSUInteger i = 0; i < iterations; i++) {
+    @autoreleasepool {
+      ALKLayoutReplayResult result = [ALKLayoutRecorder replay:recording];
+      [samples addObject:@(result.applyTime + result.layoutTime)];
+      constraints = result.constraints;
+    }
+  }
+  
+  NSMutableDictionary *result = [[self resultNamed:name kind:@"replay" count:constraints samples:samples root:nil] mutableCopy];
+  result[@"constraints"] = @(constraints);
+  return result;
+}
+
+#pragma mark - Statistics & Report
+
++ (NSDictionary *)statisticsOfSamples:(NSArray<NSNumber *> *)samples
+{
+  if (samples.count == 0) return @{};
+  
+  NSArray<NSNumber *> *sorted = [samples sortedArrayUsingSelector:@selector(compare:)];
+  double (^percentile)(double) = ^double(double p) {
+    // nearest rank
+    NSUInteger rank = (NSUInteger)ceil(p * (double)sorted.count);
+    return [sorted[MIN(MAX(rank, (NSUInteger)1), sorted.count) - 1] doubleValue] * 1000.0;
+  };
+  
+  return @{ @"p50": @(percentile(0.50)),
+            @"p95": @(percentile(0.95)),
+            @"p99": @(percentile(0.99)),
+            @"max": @([[sorted lastObject] doubleValue] * 1000.0),
+            @"mean": @([[samples valueForKeyPath:@"@avg.self"] doubleValue] * 1000.0) };
+}
+
++ (NSData *)reportWithResults:(NSArray<NSDictionary *> *)results
+{
+  NSDictionary *report = @{ @"device": [UIDevice currentDevice].model,
+                            @"system": [UIDevice currentDevice].systemVersion,
+                            @"physicalFootprint": @([self physicalFootprint]),
+                            @"peakPhysicalFootprint": @([self peakPhysicalFootprint]),
+                            @"layoutFootprint": @(ALKLayoutFootprintTotal([UIView alk_processLayoutFootprint])),
+                            @"poolHitRate": @([ALKConstraintPool sharedPool].hitRate),
+                            @"benchmarks": results };
+  
+  NSJSONWritingOptions options = NSJSONWritingPrettyPrinted;
+  if (@available(iOS 11, *)) {
+    options |= NSJSONWritingSortedKeys;
+  }
+  return [NSJSONSerialization dataWithJSONObject:report options:options error:NULL];
+}
+
+#pragma mark - Helper
+
++ (NSDictionary *)resultNamed:(NSString *)name kind:(NSString *)kind count:(NSUInteger)count samples:(NSArray *)samples root:(UIView *)root
+{
+  NSMutableDictionary *result = [[self statisticsOfSamples:samples] mutableCopy];
+  result[@"name"] = name;
+  result[@"kind"] = kind;
+  result[@"count"] = @(count);
+  result[@"iterations"] = @(samples.count);
+  
+  if (root) {
+    ALKLayoutFootprint footprint = [root alk_layoutFootprint];
+    result[@"constraints"] = @(footprint.constraints);
+    result[@"bytes"] = @(ALKLayoutFootprintTotal(footprint));
+  }
+  
+  return result;
+}
+
+// Named constraints are stored on their target view, which for the deep tree
+// is the parent of the constrained view.
++ (NSArray<UIView *> *)viewsWithEditableConstraintIn:(UIView *)root
+{
+  NSMutableArray *views = [NSMutableArray array];
+  NSMutableArray *stack = [NSMutableArray arrayWithObject:root];
+  while (stack.count > 0) {
+    UIView *view = [stack lastObject];
+    [stack removeLastObject];
+    if ([view alk_constraintWithName:kALKBenchmarkEditableConstraint]) [views addObject:view];
+    [stack addObjectsFromArray:view.subviews];
+  }
+  
+  return views;
+}
+
++ (uint64_t)physicalFootprint
+{
+  task_vm_info_data_t info;
+  mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+  if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) return 0;
+  return info.phys_footprint;
+}
+
++ (uint64_t)peakPhysicalFootprint
+{
+  task_vm_info_data_t info;
+  mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+  if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) return 0;
+  
+  // older kernels do not report the peak
+  return (count >= TASK_VM_INFO_REV3_COUNT) ? (uint64_t)info.ledger_phys_footprint_peak : info.phys_footprint;
+}
+
+@end
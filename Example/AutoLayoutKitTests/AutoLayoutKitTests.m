@@ -171,4 +171,152 @@ NSString * const kALKBaseTestConstraint = @"ALKTestConstraint";
   XCTAssertNotEqualWithAccuracy(constraint.constant, constant2, 0.001, @"");
 }
 
+- (void)testCompactionDropsConstraintsOfDeallocatedViews
+{
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectZero];
+  __weak UIView *weakChildView = nil;
+  __weak NSLayoutConstraint *weakConstraint = nil;
+  
+  @autoreleasepool {
+    UIView *childView = [[UIView alloc] initWithFrame:CGRectZero];
+    [parentView addSubview:childView];
+    weakChildView = childView;
+    
+    [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+      [c make:ALKWidth equalTo:parentView s:ALKWidth name:kALKBaseTestConstraint];
+    }];
+    
+    weakConstraint = [parentView alk_constraintWithName:kALKBaseTestConstraint];
+    [childView removeFromSuperview];
+  }
+  
+  XCTAssertNil(weakChildView, @"");
+  XCTAssertEqual([parentView alk_compactNamedConstraints], (NSUInteger)1, @"");
+  XCTAssertNil([parentView alk_constraintWithName:kALKBaseTestConstraint], @"");
+  XCTAssertNil(weakConstraint, @"");
+}
+
+- (void)testCompactionKeepsConstraintsOfDetachedViews
+{
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectZero];
+  UIView *childView = [[UIView alloc] initWithFrame:CGRectZero];
+  [parentView addSubview:childView];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c make:ALKWidth equalTo:parentView s:ALKWidth name:kALKBaseTestConstraint];
+  }];
+  
+  // detached only while it is re-parented
+  [childView removeFromSuperview];
+  
+  XCTAssertEqual([parentView alk_compactNamedConstraints], (NSUInteger)0, @"");
+  XCTAssertNotNil([parentView alk_constraintWithName:kALKBaseTestConstraint], @"");
+  
+  [parentView addSubview:childView];
+  [parentView alk_constraintWithName:kALKBaseTestConstraint].active = YES;
+  XCTAssertTrue([parentView alk_constraintWithName:kALKBaseTestConstraint].active, @"");
+}
+
+- (void)testCompactionKeepsConstraintsOfLiveViews
+{
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectZero];
+  UIView *childView = [[UIView alloc] initWithFrame:CGRectZero];
+  [parentView addSubview:childView];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c make:ALKWidth equalTo:parentView s:ALKWidth name:kALKBaseTestConstraint];
+  }];
+  
+  XCTAssertEqual([parentView alk_compactNamedConstraints], (NSUInteger)0, @"");
+  XCTAssertNotNil([parentView alk_constraintWithName:kALKBaseTestConstraint], @"");
+}
+
+- (void)testAddingConstraintsCompactsTheRegistry
+{
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectZero];
+  
+  for (NSUInteger i = 0; i < 100; i++) {
+    @autoreleasepool {
+      UIView *childView = [[UIView alloc] initWithFrame:CGRectZero];
+      [parentView addSubview:childView];
+      
+      [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+        [c make:ALKWidth equalTo:parentView s:ALKWidth name:[NSString stringWithFormat:@"constraint-%lu", (unsigned long)i]];
+      }];
+      
+      [childView removeFromSuperview];
+    }
+  }
+  
+  XCTAssertLessThan([parentView.alk_namedConstraints count], (NSUInteger)100, @"");
+}
+
+- (void)testSetConstantsOnlyChangesDifferentConstants
+{
+  UIView *view = [[UIView alloc] initWithFrame:CGRectZero];
+  
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    [c set:ALKWidth to:10.f name:@"width"];
+    [c set:ALKHeight to:20.f name:@"height"];
+  }];
+  
+  NSUInteger changed = [view alk_setConstants:@{ @"width": @10.f, @"height": @30.f, @"unknown": @1.f }];
+  
+  XCTAssertEqual(changed, (NSUInteger)1, @"");
+  XCTAssertEqualWithAccuracy([view alk_constraintWithName:@"width"].constant, 10.f, 0.001, @"");
+  XCTAssertEqualWithAccuracy([view alk_constraintWithName:@"height"].constant, 30.f, 0.001, @"");
+}
+
+#pragma mark - Safe Area Tests
+
+- (void)testSafeAreaConstraintsShareTheRelatedLayoutGuide
+{
+  UIView *parentView  = [[UIView alloc] initWithFrame:CGRectZero];
+  UIView *childView   = [[UIView alloc] initWithFrame:CGRectZero];
+  [parentView addSubview:childView];
+  
+  __block NSLayoutConstraint *top = nil;
+  __block NSLayoutConstraint *bottom = nil;
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    top     = [c make:ALKTop    equalToSafeArea:parentView s:ALKTop];
+    bottom  = [c make:ALKBottom equalToSafeArea:parentView s:ALKBottom minus:10.f];
+  }];
+  
+  XCTAssertEqual(top.firstItem, childView, @"");
+  XCTAssertEqual(bottom.firstItem, childView, @"");
+  XCTAssertEqual(top.secondItem, bottom.secondItem, @"");
+  XCTAssertEqualWithAccuracy(bottom.constant, -10.f, 0.001, @"");
+  
+  if (@available(iOS 11, *)) {
+    XCTAssertEqual(top.secondItem, parentView.safeAreaLayoutGuide, @"");
+  } else {
+    XCTAssertEqual(top.secondItem, parentView, @"");
+  }
+}
+
+- (void)testRebuiltSafeAreaLayoutReusesAnchors
+{
+  UIView *parentView  = [[UIView alloc] initWithFrame:CGRectZero];
+  UIView *childView   = [[UIView alloc] initWithFrame:CGRectZero];
+  [parentView addSubview:childView];
+  
+  NSUInteger (^build)(void) = ^NSUInteger {
+    NSUInteger before = [ALKConstraints resolvedAnchorCount];
+    __block NSLayoutConstraint *top = nil;
+    __block NSLayoutConstraint *bottom = nil;
+    [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+      top     = [c make:ALKTop    equalToSafeArea:parentView s:ALKTop];
+      bottom  = [c make:ALKBottom equalToSafeArea:parentView s:ALKBottom];
+    }];
+    [NSLayoutConstraint deactivateConstraints:@[ top, bottom ]];
+    return [ALKConstraints resolvedAnchorCount] - before;
+  };
+  
+  if (@available(iOS 11, *)) {
+    XCTAssertEqual(build(), (NSUInteger)4, @"");
+    XCTAssertEqual(build(), (NSUInteger)0, @"");
+  }
+}
+
 @end
@@ -0,0 +1,181 @@
+//  BenchmarkTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "ALKBenchmark.h"
+#import "AutoLayoutKit.h"
+
+/**
+ Runs the layout benchmark suite and writes a JSON report.
+ 
+ The suite only runs if `ALK_BENCH` is set in the environment of the test run,
+ e.g. by `rake bench:run`, and is configured through the environment as well:
+ 
+ - `ALK_BENCH_SCALE`: comma separated view counts (default `100,1000`)
+ - `ALK_BENCH_ITERATIONS`: samples per benchmark (default `50`)
+ - `ALK_BENCH_RECORDING`: a stream recorded with `ALKLayoutRecorder` to replay
+ - `ALK_BENCH_OUTPUT`: where to write the report (default `alk-bench.json` in
+   the temporary directory)
+ */
+@interface BenchmarkTests : ALKTestCase
+
+@end
+
+@implementation BenchmarkTests
+
+- (NSDictionary *)environment
+{
+  return [NSProcessInfo processInfo].environment;
+}
+
+- (NSArray<NSNumber *> *)scales
+{
+  NSString *scale = self.environment[@"ALK_BENCH_SCALE"] ?: @"100,1000";
+  NSMutableArray *scales = [NSMutableArray array];
+  for (NSString *component in [scale componentsSeparatedByString:@","]) {
+    NSInteger count = component.integerValue;
+    if (count > 0) [scales addObject:@(count)];
+  }
+  return scales;
+}
+
+- (NSUInteger)iterations
+{
+  NSInteger iterations = [self.environment[@"ALK_BENCH_ITERATIONS"] integerValue];
+  return iterations > 0 ? (NSUInteger)iterations : 50;
+}
+
+- (NSArray<NSValue *> *)containerSizes
+{
+  return @[ [NSValue valueWithCGSize:CGSizeMake(320.f, 568.f)],
+            [NSValue valueWithCGSize:CGSizeMake(375.f, 667.f)],
+            [NSValue valueWithCGSize:CGSizeMake(768.f, 1024.f)],
+            [NSValue valueWithCGSize:CGSizeMake(1024.f, 768.f)] ];
+}
+
+- (void)testStatisticsUseNearestRank
+{
+  NSMutableArray *samples = [NSMutableArray array];
+  for (NSUInteger i = 100; i > 0; i--) {
+    [samples addObject:@(i / 1000.0)];
+  }
+  
+  NSDictionary *statistics = [ALKBenchmark statisticsOfSamples:samples];
+  XCTAssertEqualWithAccuracy([statistics[@"p50"] doubleValue], 50.0, 0.0001, @"");
+  XCTAssertEqualWithAccuracy([statistics[@"p95"] doubleValue], 95.0, 0.0001, @"");
+  XCTAssertEqualWithAccuracy([statistics[@"p99"] doubleValue], 99.0, 0.0001, @"");
+  XCTAssertEqualWithAccuracy([statistics[@"max"] doubleValue], 100.0, 0.0001, @"");
+  XCTAssertEqualWithAccuracy([statistics[@"mean"] doubleValue], 50.5, 0.0001, @"");
+}
+
+- (void)testGeneratedLayoutsAreEditable
+{
+  for (ALKBenchmarkShape shape = ALKBenchmarkShapeChain; shape <= ALKBenchmarkShapeGrid; shape++) {
+    UIView *root = [ALKBenchmark layoutWithShape:shape count:16];
+    [root layoutIfNeeded];
+    
+    NSDictionary *result = [ALKBenchmark measureLayoutOfRoot:root
+                                                        name:[ALKBenchmark nameOfShape:shape]
+                                              containerSizes:self.containerSizes
+                                                       edits:4
+                                                  iterations:8];
+    XCTAssertEqualObjects(result[@"iterations"], @8, @"%@", [ALKBenchmark nameOfShape:shape]);
+    XCTAssertGreaterThan([result[@"constraints"] unsignedIntegerValue], (NSUInteger)16, @"%@", [ALKBenchmark nameOfShape:shape]);
+    
+    NSDictionary *lookups = [ALKBenchmark measureNamedLookupsOfRoot:root name:@"lookup" iterations:1];
+    XCTAssertEqualObjects(lookups[@"count"], @16, @"%@", [ALKBenchmark nameOfShape:shape]);
+  }
+}
+
+- (void)testBenchmarkSuite
+{
+  // too slow for every test run
+  if ([self.environment[@"ALK_BENCH"] length] == 0) return;
+  
+  NSUInteger iterations = self.iterations;
+  NSMutableArray *results = [NSMutableArray array];
+  
+  for (NSNumber *scale in self.scales) {
+    NSUInteger count = scale.unsignedIntegerValue;
+    
+    for (ALKBenchmarkShape shape = ALKBenchmarkShapeChain; shape <= ALKBenchmarkShapeGrid; shape++) {
+      NSString *name = [NSString stringWithFormat:@"%@-%lu", [ALKBenchmark nameOfShape:shape], (unsigned long)count];
+      
+      // deep trees of a thousand levels mostly measure UIKit's recursion
+      NSUInteger shapeIterations = (shape == ALKBenchmarkShapeDeepTree) ? MAX(iterations / 10, (NSUInteger)1) : iterations;
+      
+      [results addObject:[ALKBenchmark measureConstructionOfShape:shape count:count iterations:MIN(shapeIterations, (NSUInteger)10)]];
+      
+      UIView *root = [ALKBenchmark layoutWithShape:shape count:count];
+      [results addObject:[ALKBenchmark measureLayoutOfRoot:root
+                                                      name:name
+                                            containerSizes:self.containerSizes
+                                                     edits:MAX(count / 100, (NSUInteger)1)
+                                                iterations:shapeIterations]];
+      [results addObject:[ALKBenchmark measureNamedLookupsOfRoot:root name:name iterations:shapeIterations]];
+    }
+    
+    [results addObject:[ALKBenchmark measureRegistryLookupsOfCount:count iterations:iterations]];
+  }
+  
+  NSString *recording = self.environment[@"ALK_BENCH_RECORDING"];
+  if (recording.length > 0) {
+    NSData *data = [NSData dataWithContentsOfFile:recording];
+    XCTAssertNotNil(data, @"cannot read %@", recording);
+    if (data) {
+      [results addObject:[ALKBenchmark measureReplayOfRecording:data name:recording.lastPathComponent iterations:iterations]];
+    }
+  }
+  
+  NSData *report = [ALKBenchmark reportWithResults:results];
+  XCTAssertNotNil(report, @"");
+  
+  NSString *output = self.environment[@"ALK_BENCH_OUTPUT"] ?: [NSTemporaryDirectory() stringByAppendingPathComponent:@"alk-bench.json"];
+  XCTAssertTrue([report writeToFile:output atomically:YES], @"cannot write %@", output);
+  
+  NSLog(@"AutoLayoutKit benchmark report (%@):\n%@", output, [[NSString alloc] initWithData:report encoding:NSUTF8StringEncoding]);
+}
+
+- (void)testReplayOfRecordedLayout
+{
+  ALKLayoutRecorder *recorder = [ALKLayoutRecorder startRecording];
+  UIView *root = [ALKBenchmark layoutWithShape:ALKBenchmarkShapeGrid count:64];
+  NSData *recording = [recorder stopRecording];
+  
+  NSDictionary *result = [ALKBenchmark measureReplayOfRecording:recording name:@"grid-64" iterations:3];
+  XCTAssertEqualObjects(result[@"kind"], @"replay", @"");
+  XCTAssertEqualObjects(result[@"constraints"], @(64 * 4), @"");
+}
+
+- (void)testConstructionReportsAllocations
+{
+  NSDictionary *result = [ALKBenchmark measureConstructionOfShape:ALKBenchmarkShapeChain count:16 iterations:2];
+  XCTAssertGreaterThan([result[@"allocations"] longLongValue], 0, @"");
+  XCTAssertGreaterThan([result[@"allocatedBytes"] longLongValue], 0, @"");
+  
+  NSDictionary *report = [NSJSONSerialization JSONObjectWithData:[ALKBenchmark reportWithResults:@[ result ]] options:0 error:NULL];
+  XCTAssertGreaterThanOrEqual([report[@"peakPhysicalFootprint"] unsignedLongLongValue], [report[@"physicalFootprint"] unsignedLongLongValue], @"");
+}
+
+@end
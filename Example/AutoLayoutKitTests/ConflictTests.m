@@ -0,0 +1,238 @@
+//  ConflictTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface ConflictTests : ALKTestCase
+
+@property (nonatomic, strong) UIView *parentView;
+@property (nonatomic, strong) UIView *childView;
+
+@end
+
+@implementation ConflictTests
+
+- (void)setUp
+{
+  [super setUp];
+  self.parentView = [self newTwoTierViewHierarchy];
+  self.parentView.frame = CGRectMake(0.f, 0.f, 200.f, 100.f);
+  self.childView = [self.parentView viewWithTag:tag];
+  
+  UIView *parentView = self.parentView;
+  [ALKConstraints layout:self.childView do:^(ALKConstraints *c) {
+    [c make:ALKLeft equalTo:parentView s:ALKLeft name:@"left"];
+    [c make:ALKRight equalTo:parentView s:ALKRight name:@"right"];
+    [c make:ALKTop equalTo:parentView s:ALKTop name:@"top"];
+    [c set:ALKHeight to:10.f name:@"height"];
+  }];
+}
+
+- (void)tearDown
+{
+  self.parentView = nil;
+  self.childView = nil;
+  [super tearDown];
+}
+
+- (NSLayoutConstraint *)widthConstraint:(CGFloat)width
+{
+  return [NSLayoutConstraint constraintWithItem:self.childView attribute:NSLayoutAttributeWidth
+                                      relatedBy:NSLayoutRelationEqual
+                                         toItem:nil attribute:NSLayoutAttributeNotAnAttribute
+                                     multiplier:1.f constant:width];
+}
+
+- (void)testConsistentLayoutHasNoConflicts
+{
+  ALKConflictExplainer *explainer = [ALKConflictExplainer explainerForView:self.parentView];
+  
+  XCTAssertEqual(explainer.conflicts.count, (NSUInteger)0, @"");
+  // 4 for the fixed frame of the parent, 4 constraints
+  XCTAssertEqual(explainer.rowCount, (NSUInteger)8, @"");
+}
+
+- (void)testExplainsMinimalConflictWithNames
+{
+  ALKConflictExplainer *explainer = [ALKConflictExplainer explainerForView:self.parentView];
+  NSLayoutConstraint *width = [self widthConstraint:50.f];
+  
+  ALKConstraintConflict *conflict = [explainer explainConstraint:width];
+  XCTAssertNotNil(conflict, @"");
+  XCTAssertEqual(conflict.constraint, width, @"");
+  
+  NSArray *expected = @[ [self.parentView alk_constraintWithName:@"left"],
+                         [self.parentView alk_constraintWithName:@"right"],
+                         width ];
+  XCTAssertEqualObjects([NSSet setWithArray:conflict.constraints], [NSSet setWithArray:expected], @"");
+  
+  // the vertical constraints are not part of it, the width of the parent is
+  XCTAssertEqual(conflict.labels.count, (NSUInteger)4, @"");
+  XCTAssertTrue([conflict.labels containsObject:@"left"], @"");
+  XCTAssertTrue([conflict.labels containsObject:@"right"], @"");
+  XCTAssertFalse([conflict.labels containsObject:@"top"], @"");
+  XCTAssertFalse([conflict.labels containsObject:@"height"], @"");
+  XCTAssertTrue([[conflict.labels firstObject] hasPrefix:@"frame of <UIView"], @"");
+}
+
+- (void)testExplainingDoesNotCreateNameTables
+{
+  UIView *rootView = [self newEmptyView];
+  [rootView addSubview:self.parentView];
+  NSUInteger ownerCount = [[UIView alk_viewsWithNamedConstraints] count];
+  
+  ALKConflictExplainer *explainer = [ALKConflictExplainer explainerForView:rootView];
+  ALKConstraintConflict *conflict = [explainer explainConstraint:[self widthConstraint:50.f]];
+  XCTAssertTrue([conflict.labels containsObject:@"left"], @"");
+  
+  XCTAssertEqual([[UIView alk_viewsWithNamedConstraints] count], ownerCount, @"");
+  XCTAssertNil([rootView alk_existingNamedConstraints], @"");
+}
+
+- (void)testRedundantConstraintIsNoConflict
+{
+  ALKConflictExplainer *explainer = [ALKConflictExplainer explainerForView:self.parentView];
+  NSUInteger rows = explainer.rowCount;
+  
+  XCTAssertNil([explainer explainConstraint:[self widthConstraint:200.f]], @"");
+  XCTAssertEqual(explainer.rowCount, rows, @"");
+}
+
+- (void)testKeepsCompatibleConstraints
+{
+  UIView *view = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 200.f, 100.f)];
+  UIView *childView = [[UIView alloc] initWithFrame:CGRectZero];
+  childView.translatesAutoresizingMaskIntoConstraints = NO;
+  [view addSubview:childView];
+  
+  ALKConflictExplainer *explainer = [ALKConflictExplainer explainerForView:view];
+  NSLayoutConstraint *first = [NSLayoutConstraint constraintWithItem:childView attribute:NSLayoutAttributeWidth
+                                                           relatedBy:NSLayoutRelationEqual
+                                                              toItem:view attribute:NSLayoutAttributeWidth
+                                                          multiplier:.5f constant:0.f];
+  NSLayoutConstraint *second = [NSLayoutConstraint constraintWithItem:childView attribute:NSLayoutAttributeWidth
+                                                            relatedBy:NSLayoutRelationEqual
+                                                               toItem:nil attribute:NSLayoutAttributeNotAnAttribute
+                                                           multiplier:1.f constant:120.f];
+  
+  XCTAssertNil([explainer explainConstraint:first], @"");
+  
+  ALKConstraintConflict *conflict = [explainer explainConstraint:second];
+  XCTAssertEqualObjects(conflict.constraints, (@[ first, second ]), @"");
+}
+
+- (void)testSkipsInequalitiesAndOptionalConstraints
+{
+  ALKConflictExplainer *explainer = [ALKConflictExplainer explainerForView:self.parentView];
+  
+  NSLayoutConstraint *lessThan = [NSLayoutConstraint constraintWithItem:self.childView attribute:NSLayoutAttributeWidth
+                                                              relatedBy:NSLayoutRelationLessThanOrEqual
+                                                                 toItem:nil attribute:NSLayoutAttributeNotAnAttribute
+                                                             multiplier:1.f constant:50.f];
+  NSLayoutConstraint *optional = [self widthConstraint:50.f];
+  optional.priority = UILayoutPriorityDefaultHigh;
+  
+  XCTAssertNil([explainer explainConstraint:lessThan], @"");
+  XCTAssertNil([explainer explainConstraint:optional], @"");
+}
+
+- (void)testRootWithoutAutoresizingIsNotFixed
+{
+  // the root is sized by its own constraint, not by its current frame
+  UIView *parentView = self.parentView;
+  [ALKConstraints layout:parentView do:^(ALKConstraints *c) {
+    [c set:ALKWidth to:300.f name:@"rootWidth"];
+  }];
+  
+  ALKConflictExplainer *explainer = [ALKConflictExplainer explainerForView:parentView];
+  XCTAssertEqual(explainer.conflicts.count, (NSUInteger)0, @"");
+  XCTAssertNil([explainer explainConstraint:[self widthConstraint:300.f]], @"");
+  XCTAssertNotNil([explainer explainConstraint:[self widthConstraint:50.f]], @"");
+}
+
+- (void)testSkipsBaselines
+{
+  ALKConflictExplainer *explainer = [ALKConflictExplainer explainerForView:self.parentView];
+  NSUInteger rowCount = explainer.rowCount;
+  
+  // the baseline of a view is not its bottom, this would be a false conflict otherwise
+  NSLayoutConstraint *baseline = [NSLayoutConstraint constraintWithItem:self.childView attribute:NSLayoutAttributeLastBaseline
+                                                              relatedBy:NSLayoutRelationEqual
+                                                                 toItem:self.parentView attribute:NSLayoutAttributeTop
+                                                             multiplier:1.f constant:5.f];
+  
+  XCTAssertNil([explainer explainConstraint:baseline], @"");
+  XCTAssertEqual(explainer.rowCount, rowCount, @"");
+}
+
+- (void)testFindsConflictsWhileLoading
+{
+  UIView *parentView = self.parentView;
+  [ALKConstraints layout:self.childView do:^(ALKConstraints *c) {
+    [c set:ALKWidth to:50.f name:@"width"];
+  }];
+  
+  ALKConflictExplainer *explainer = [ALKConflictExplainer explainerForView:parentView];
+  XCTAssertEqual(explainer.conflicts.count, (NSUInteger)1, @"");
+  
+  NSArray *labels = [explainer.conflicts firstObject].labels;
+  XCTAssertTrue([labels containsObject:@"left"], @"");
+  XCTAssertTrue([labels containsObject:@"right"], @"");
+  XCTAssertTrue([labels containsObject:@"width"], @"");
+}
+
+- (void)testManyConstraintsStayIncremental
+{
+  UIView *view = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 1000.f, 1000.f)];
+  UIView *previous = nil;
+  for (NSUInteger i = 0; i < 500; i++) {
+    UIView *cell = [[UIView alloc] initWithFrame:CGRectZero];
+    [view addSubview:cell];
+    UIView *above = previous;
+    [ALKConstraints layout:cell do:^(ALKConstraints *c) {
+      [c make:ALKLeft equalTo:view s:ALKLeft];
+      [c make:ALKRight equalTo:view s:ALKRight];
+      [c make:ALKTop equalTo:(above ?: view) s:(above ? ALKBottom : ALKTop)];
+      [c set:ALKHeight to:3.f];
+    }];
+    previous = cell;
+  }
+  
+  ALKConflictExplainer *explainer = [ALKConflictExplainer explainerForView:view];
+  XCTAssertEqual(explainer.conflicts.count, (NSUInteger)0, @"");
+  
+  // pinning the last cell to the bottom of the container contradicts the heights
+  NSLayoutConstraint *bottom = [NSLayoutConstraint constraintWithItem:previous attribute:NSLayoutAttributeBottom
+                                                            relatedBy:NSLayoutRelationEqual
+                                                               toItem:view attribute:NSLayoutAttributeBottom
+                                                           multiplier:1.f constant:0.f];
+  
+  ALKConstraintConflict *conflict = [explainer explainConstraint:bottom];
+  
+  // every top and height of the chain plus the new constraint
+  XCTAssertEqual(conflict.constraints.count, (NSUInteger)(2 * 500 + 1), @"");
+}
+
+@end
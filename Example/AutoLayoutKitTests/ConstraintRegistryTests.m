@@ -0,0 +1,232 @@
+//  ConstraintRegistryTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+NSString * const kALKRegistryTestConstraint = @"ALKRegistryTestConstraint";
+
+@interface ConstraintRegistryTests : ALKTestCase
+
+@end
+
+@implementation ConstraintRegistryTests
+
+- (void)setUp
+{
+  [super setUp];
+  [[ALKConstraintRegistry sharedRegistry] resetMergedConstraintCount];
+}
+
+- (void)testIdenticalRelationsShareOneConstraint
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c shareConstraints];
+    [c alignAllEdgesTo:parentView];
+  }];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c shareConstraints];
+    [c alignAllEdgesTo:parentView];
+  }];
+  
+  XCTAssertEqual([parentView.constraints count], (NSUInteger)4, @"");
+  XCTAssertEqual([ALKConstraintRegistry sharedRegistry].mergedConstraintCount, (NSUInteger)4, @"");
+}
+
+- (void)testRelationsAreNotSharedByDefault
+{
+  UIView *view = [self newEmptyView];
+  
+  __block NSLayoutConstraint *first = nil;
+  __block NSLayoutConstraint *second = nil;
+  
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    first = [c set:ALKWidth to:100.f];
+  }];
+  
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    second = [c set:ALKWidth to:100.f];
+  }];
+  
+  XCTAssertNotEqual(first, second, @"");
+  XCTAssertEqual([ALKConstraintRegistry sharedRegistry].mergedConstraintCount, (NSUInteger)0, @"");
+  
+  // one owner giving up its constraint leaves the other one alone
+  first.active = NO;
+  XCTAssertTrue(second.active, @"");
+}
+
+- (void)testSharedConstraintStaysActiveUntilTheLastOwnerReleasesIt
+{
+  UIView *view = [self newEmptyView];
+  
+  __block NSLayoutConstraint *first = nil;
+  __block NSLayoutConstraint *second = nil;
+  
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    [c shareConstraints];
+    first = [c set:ALKWidth to:100.f];
+  }];
+  
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    [c shareConstraints];
+    second = [c set:ALKWidth to:100.f];
+  }];
+  
+  XCTAssertEqual(first, second, @"");
+  
+  ALKConstraintRegistry *registry = [ALKConstraintRegistry sharedRegistry];
+  XCTAssertEqual([registry releaseConstraint:first], (NSUInteger)1, @"");
+  XCTAssertTrue(second.active, @"");
+  
+  XCTAssertEqual([registry releaseConstraint:second], (NSUInteger)0, @"");
+  XCTAssertFalse(second.active, @"");
+}
+
+- (void)testDifferentConstantsAreNotShared
+{
+  UIView *view = [self newEmptyView];
+  
+  __block NSLayoutConstraint *first = nil;
+  __block NSLayoutConstraint *second = nil;
+  
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    [c shareConstraints];
+    first = [c set:ALKWidth to:100.f];
+    second = [c set:ALKWidth to:100.f];
+  }];
+  
+  XCTAssertEqual(first, second, @"");
+  
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    [c shareConstraints];
+    second = [c set:ALKWidth to:101.f];
+  }];
+  
+  XCTAssertNotEqual(first, second, @"");
+  XCTAssertEqual([ALKConstraintRegistry sharedRegistry].mergedConstraintCount, (NSUInteger)1, @"");
+}
+
+- (void)testDifferentPrioritiesAreNotShared
+{
+  UIView *view = [self newEmptyView];
+  
+  __block NSLayoutConstraint *first = nil;
+  __block NSLayoutConstraint *second = nil;
+  
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    [c shareConstraints];
+    first = [c set:ALKWidth to:100.f];
+    [c setPriorityDefaultLow];
+    second = [c set:ALKWidth to:100.f];
+  }];
+  
+  XCTAssertNotEqual(first, second, @"");
+  XCTAssertEqual([ALKConstraintRegistry sharedRegistry].mergedConstraintCount, (NSUInteger)0, @"");
+}
+
+- (void)testDeactivatedConstraintsAreNotShared
+{
+  UIView *view = [self newEmptyView];
+  
+  __block NSLayoutConstraint *first = nil;
+  __block NSLayoutConstraint *second = nil;
+  
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    [c shareConstraints];
+    first = [c set:ALKWidth to:100.f];
+  }];
+  
+  first.active = NO;
+  
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    [c shareConstraints];
+    second = [c set:ALKWidth to:100.f];
+  }];
+  
+  XCTAssertNotEqual(first, second, @"");
+  XCTAssertTrue(second.active, @"");
+}
+
+- (void)testNamedConstraintsAreNotShared
+{
+  UIView *view = [self newEmptyView];
+  NSString *otherName = @"ALKRegistryTestOtherConstraint";
+  
+  __block NSLayoutConstraint *unnamed = nil;
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    [c shareConstraints];
+    // optional, so changing one of them does not conflict with the others
+    [c setPriorityDefaultLow];
+    [c set:ALKHeight to:50.f name:kALKRegistryTestConstraint];
+    [c set:ALKHeight to:50.f name:otherName];
+    unnamed = [c set:ALKHeight to:50.f];
+  }];
+  
+  NSLayoutConstraint *constraint = [view alk_constraintWithName:kALKRegistryTestConstraint];
+  NSLayoutConstraint *other = [view alk_constraintWithName:otherName];
+  XCTAssertNotEqual(constraint, other, @"");
+  XCTAssertNotEqual(constraint, unnamed, @"");
+  XCTAssertNotEqual(other, unnamed, @"");
+  XCTAssertEqual([ALKConstraintRegistry sharedRegistry].mergedConstraintCount, (NSUInteger)0, @"");
+  
+  [view alk_setConstant:60.f forConstraintWithName:kALKRegistryTestConstraint];
+  XCTAssertEqualWithAccuracy(other.constant, 50.f, 0.001, @"");
+  XCTAssertEqualWithAccuracy(unnamed.constant, 50.f, 0.001, @"");
+  
+  [view alk_removeConstraintWithName:kALKRegistryTestConstraint];
+  XCTAssertFalse(constraint.active, @"");
+  XCTAssertTrue(other.active, @"");
+  XCTAssertTrue(unnamed.active, @"");
+}
+
+- (void)testRegistryGrowsAndKeepsEveryRelation
+{
+  ALKConstraintRegistry *registry = [[ALKConstraintRegistry alloc] init];
+  UIView *view = [self newEmptyView];
+  NSMutableArray<NSLayoutConstraint *> *constraints = [NSMutableArray array];
+  
+  // width <= i never conflicts, whatever the number of constraints
+  for (NSUInteger i = 0; i < 1000; i++) {
+    NSLayoutConstraint *lc = [NSLayoutConstraint constraintWithItem:view attribute:NSLayoutAttributeWidth relatedBy:NSLayoutRelationLessThanOrEqual toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.f constant:(CGFloat)i];
+    lc.active = YES;
+    [registry registerConstraint:lc];
+    [constraints addObject:lc];
+  }
+  
+  [constraints enumerateObjectsUsingBlock:^(NSLayoutConstraint *lc, NSUInteger idx, BOOL *stop) {
+    NSLayoutConstraint *found = [registry constraintWithItem:view attribute:ALKWidth relatedBy:ALKLessThan toItem:nil attribute:ALKNone multiplier:1.f constant:(CGFloat)idx priority:UILayoutPriorityRequired];
+    XCTAssertEqual(found, lc, @"%lu", (unsigned long)idx);
+  }];
+  XCTAssertEqual(registry.mergedConstraintCount, (NSUInteger)1000, @"");
+  
+  [NSLayoutConstraint deactivateConstraints:constraints];
+  XCTAssertNil([registry constraintWithItem:view attribute:ALKWidth relatedBy:ALKLessThan toItem:nil attribute:ALKNone multiplier:1.f constant:0.f priority:UILayoutPriorityRequired], @"");
+}
+
+@end
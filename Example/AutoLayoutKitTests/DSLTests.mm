@@ -0,0 +1,105 @@
+//  DSLTests.mm
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+#import "ALKLayoutDSL.h"
+
+using namespace alk;
+
+// 0: parent, 1: child
+static constexpr auto kDSLTestLayout = layout(
+  left(1) == left(0) + 10,
+  top(1) >= bottom(0) * 0.5 - 4,
+  size(width(1), 100),
+  named(height(1) <= height(0), "height"),
+  priority(centerX(1) == centerX(0), 250)
+);
+
+static_assert(kDSLTestLayout.size() == 5, "every expression becomes one spec");
+static_assert(kDSLTestLayout[1].multiplier == 0.5 && kDSLTestLayout[1].constant == -4, "terms are folded at compile time");
+static_assert(kDSLTestLayout[2].relatedItem == ALKSpecNoItem, "constants have no related item");
+
+@interface DSLTests : ALKTestCase
+
+@end
+
+@implementation DSLTests
+
+- (void)testTableIsApplied
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  NSArray<NSLayoutConstraint *> *constraints = apply(kDSLTestLayout, @[parentView, childView]);
+  XCTAssertEqual([constraints count], kDSLTestLayout.size(), @"");
+  XCTAssertFalse(childView.translatesAutoresizingMaskIntoConstraints, @"");
+  
+  [self checkConstraint:constraints[0]
+               withItem:childView
+              attribute:NSLayoutAttributeLeft
+              relatedBy:NSLayoutRelationEqual
+                 toItem:parentView
+              attribute:NSLayoutAttributeLeft
+             multiplier:1.f
+               constant:10.f];
+  
+  [self checkConstraint:constraints[1]
+               withItem:childView
+              attribute:NSLayoutAttributeTop
+              relatedBy:NSLayoutRelationGreaterThanOrEqual
+                 toItem:parentView
+              attribute:NSLayoutAttributeBottom
+             multiplier:.5f
+               constant:-4.f];
+  
+  [self checkConstraint:constraints[2]
+               withItem:childView
+              attribute:NSLayoutAttributeWidth
+              relatedBy:NSLayoutRelationEqual
+                 toItem:nil
+              attribute:NSLayoutAttributeNotAnAttribute
+             multiplier:1.f
+               constant:100.f];
+  
+  XCTAssertEqual([parentView alk_constraintWithName:@"height"], constraints[3], @"");
+  XCTAssertEqualWithAccuracy(constraints[4].priority, UILayoutPriorityDefaultLow, 0.001, @"");
+}
+
+- (void)testPlainCTable
+{
+  UIView *view = [self newEmptyView];
+  
+  static const ALKConstraintSpec specs[] = {
+    { 0, ALKWidth, ALKEqualTo, ALKSpecNoItem, ALKNone, 1.f, 20.f, UILayoutPriorityRequired, NULL },
+    { 0, ALKHeight, ALKEqualTo, 0, ALKWidth, 2.f, 0.f, UILayoutPriorityRequired, "height" },
+  };
+  
+  NSArray<NSLayoutConstraint *> *constraints = [ALKConstraints apply:specs count:2 items:@[view]];
+  
+  XCTAssertEqual([view.constraints count], (NSUInteger)2, @"");
+  XCTAssertEqual([view alk_constraintWithName:@"height"], constraints[1], @"");
+}
+
+@end
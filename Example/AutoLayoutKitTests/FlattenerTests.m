@@ -0,0 +1,221 @@
+//  FlattenerTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface ALKMeasuringContainer : UIView
+@end
+
+@implementation ALKMeasuringContainer
+
+- (CGSize)intrinsicContentSize
+{
+  return CGSizeMake(100.f, 300.f);
+}
+
+@end
+
+@interface FlattenerTests : ALKTestCase
+
+@property (nonatomic, strong) UIView *parentView;
+@property (nonatomic, strong) ALKMeasuringContainer *container;
+@property (nonatomic, strong) UIView *contentView;
+
+@end
+
+@implementation FlattenerTests
+
+- (void)setUp
+{
+  [super setUp];
+  
+  self.parentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+  self.container = [[ALKMeasuringContainer alloc] initWithFrame:CGRectZero];
+  self.contentView = [[UIView alloc] initWithFrame:CGRectZero];
+  [self.parentView addSubview:self.container];
+  [self.container addSubview:self.contentView];
+  
+  [ALKConstraints layout:self.container do:^(ALKConstraints *c) {
+    [c make:ALKTop      equalTo:self.parentView s:ALKTop];
+    [c make:ALKLeft     equalTo:self.parentView s:ALKLeft];
+    [c make:ALKRight    equalTo:self.parentView s:ALKRight];
+  }];
+  
+  [ALKConstraints layout:self.contentView do:^(ALKConstraints *c) {
+    [c make:ALKTop      equalTo:self.container s:ALKTop];
+    [c make:ALKLeft     equalTo:self.container s:ALKLeft];
+    [c make:ALKRight    equalTo:self.container s:ALKRight];
+    [c make:ALKBottom   equalTo:self.container s:ALKBottom];
+    [[c set:ALKHeight to:40.f] setPriority:500.f];
+  }];
+}
+
+- (void)tearDown
+{
+  self.contentView = nil;
+  self.container = nil;
+  self.parentView = nil;
+  
+  [super tearDown];
+}
+
+- (void)testFindsContainerPinnedToItsContent
+{
+  NSArray *nestedLayouts = [ALKLayoutFlattener nestedLayoutsInView:self.parentView];
+  
+  XCTAssertEqual(nestedLayouts.count, (NSUInteger)1, @"");
+  ALKNestedLayout *nestedLayout = nestedLayouts.firstObject;
+  XCTAssertEqual(nestedLayout.container, self.container, @"");
+  XCTAssertEqual(nestedLayout.constraintCount, (NSUInteger)5, @"");
+  XCTAssertFalse(nestedLayout.merged, @"");
+  XCTAssertEqual([self.container contentCompressionResistancePriorityForAxis:UILayoutConstraintAxisVertical],
+                 UILayoutPriorityDefaultHigh, @"");
+}
+
+- (void)testIgnoresContainersWithoutMeasuredSize
+{
+  UIView *plainContainer = [[UIView alloc] initWithFrame:CGRectZero];
+  UIView *content = [[UIView alloc] initWithFrame:CGRectZero];
+  [self.parentView addSubview:plainContainer];
+  [plainContainer addSubview:content];
+  [ALKConstraints layout:content do:^(ALKConstraints *c) {
+    [c make:ALKTop      equalTo:plainContainer s:ALKTop];
+    [c make:ALKLeft     equalTo:plainContainer s:ALKLeft];
+    [c make:ALKRight    equalTo:plainContainer s:ALKRight];
+    [c make:ALKBottom   equalTo:plainContainer s:ALKBottom];
+  }];
+  
+  NSArray *nestedLayouts = [ALKLayoutFlattener nestedLayoutsInView:self.parentView];
+  
+  XCTAssertEqual(nestedLayouts.count, (NSUInteger)1, @"");
+  XCTAssertEqual([nestedLayouts.firstObject container], self.container, @"");
+}
+
+- (void)testIgnoresContainersNotPinnedToAllEdges
+{
+  [self.container removeConstraints:[self.container.constraints filteredArrayUsingPredicate:
+                                     [NSPredicate predicateWithBlock:^BOOL(NSLayoutConstraint *lc, NSDictionary *bindings) {
+    return lc.firstAttribute == NSLayoutAttributeBottom;
+  }]]];
+  
+  XCTAssertEqual([ALKLayoutFlattener nestedLayoutsInView:self.parentView].count, (NSUInteger)0, @"");
+}
+
+- (ALKMeasuringContainer *)newContainerWithTopView:(UIView *)topView bottomView:(UIView *)bottomView
+{
+  ALKMeasuringContainer *container = [[ALKMeasuringContainer alloc] initWithFrame:CGRectZero];
+  [self.parentView addSubview:container];
+  [container addSubview:topView];
+  [container addSubview:bottomView];
+  
+  [ALKConstraints layout:topView do:^(ALKConstraints *c) {
+    [c make:ALKTop      equalTo:container s:ALKTop];
+    [c make:ALKLeft     equalTo:container s:ALKLeft];
+    [c make:ALKRight    equalTo:container s:ALKRight];
+  }];
+  
+  [ALKConstraints layout:bottomView do:^(ALKConstraints *c) {
+    [c make:ALKLeft     equalTo:container s:ALKLeft];
+    [c make:ALKRight    equalTo:container s:ALKRight];
+    [c make:ALKBottom   equalTo:container s:ALKBottom];
+  }];
+  
+  return container;
+}
+
+- (void)testIgnoresEdgesPinnedToUnrelatedSubviews
+{
+  UIView *topView = [self newEmptyView];
+  UIView *bottomView = [self newEmptyView];
+  [self newContainerWithTopView:topView bottomView:bottomView];
+  
+  // nothing connects the two subviews, so they do not determine the height
+  NSArray *nestedLayouts = [ALKLayoutFlattener nestedLayoutsInView:self.parentView];
+  
+  XCTAssertEqual(nestedLayouts.count, (NSUInteger)1, @"");
+  XCTAssertEqual([nestedLayouts.firstObject container], self.container, @"");
+}
+
+- (void)testFindsChainSpanningTheContainer
+{
+  UIView *topView = [self newEmptyView];
+  UIView *bottomView = [self newEmptyView];
+  ALKMeasuringContainer *container = [self newContainerWithTopView:topView bottomView:bottomView];
+  
+  [ALKConstraints layout:bottomView do:^(ALKConstraints *c) {
+    [c make:ALKTop      equalTo:topView s:ALKBottom plus:8.f];
+  }];
+  
+  NSArray *containers = [[ALKLayoutFlattener nestedLayoutsInView:self.parentView] valueForKey:@"container"];
+  
+  XCTAssertEqual(containers.count, (NSUInteger)2, @"");
+  XCTAssertTrue([containers containsObject:container], @"");
+}
+
+- (void)testMergedContainerIsSizedByItsContent
+{
+  [self.parentView layoutIfNeeded];
+  XCTAssertEqual(self.container.frame.size.height, 300.f, @"");
+  
+  NSArray *nestedLayouts = [ALKLayoutFlattener flattenView:self.parentView maximumConstraintCount:16];
+  [self.parentView layoutIfNeeded];
+  
+  XCTAssertTrue([nestedLayouts.firstObject merged], @"");
+  XCTAssertEqual(self.container.frame.size.height, 40.f, @"");
+  XCTAssertEqual(self.contentView.frame.size.height, 40.f, @"");
+}
+
+- (void)testUnflattenRestoresPriorities
+{
+  [self.container setContentHuggingPriority:UILayoutPriorityDefaultHigh forAxis:UILayoutConstraintAxisVertical];
+  [self.parentView layoutIfNeeded];
+  
+  NSArray *nestedLayouts = [ALKLayoutFlattener flattenView:self.parentView maximumConstraintCount:16];
+  [ALKLayoutFlattener unflattenLayouts:nestedLayouts];
+  [self.parentView layoutIfNeeded];
+  
+  XCTAssertFalse([nestedLayouts.firstObject merged], @"");
+  XCTAssertEqual([self.container contentHuggingPriorityForAxis:UILayoutConstraintAxisVertical],
+                 UILayoutPriorityDefaultHigh, @"");
+  XCTAssertEqual([self.container contentCompressionResistancePriorityForAxis:UILayoutConstraintAxisVertical],
+                 UILayoutPriorityDefaultHigh, @"");
+  XCTAssertEqual([self.container contentHuggingPriorityForAxis:UILayoutConstraintAxisHorizontal],
+                 UILayoutPriorityDefaultLow, @"");
+  XCTAssertEqual(self.container.frame.size.height, 300.f, @"");
+}
+
+- (void)testKeepsLargeContainersSeparate
+{
+  [self.parentView layoutIfNeeded];
+  
+  NSArray *nestedLayouts = [ALKLayoutFlattener flattenView:self.parentView maximumConstraintCount:4];
+  [self.parentView layoutIfNeeded];
+  
+  XCTAssertEqual(nestedLayouts.count, (NSUInteger)1, @"");
+  XCTAssertFalse([nestedLayouts.firstObject merged], @"");
+  XCTAssertEqual(self.container.frame.size.height, 300.f, @"");
+}
+
+@end
@@ -0,0 +1,97 @@
+//  FootprintTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface FootprintTests : ALKTestCase
+
+@end
+
+@implementation FootprintTests
+
+- (void)testSubtreeFootprintCountsConstraintsAndNames
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  ALKLayoutFootprint empty = [parentView alk_layoutFootprint];
+  XCTAssertEqual(empty.views, (NSUInteger)2, @"");
+  XCTAssertEqual(empty.constraints, (NSUInteger)0, @"");
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c make:ALKLeft equalTo:parentView s:ALKLeft];
+    [c set:ALKWidth to:10.f name:@"width"];
+  }];
+  
+  ALKLayoutFootprint footprint = [parentView alk_layoutFootprint];
+  XCTAssertEqual(footprint.constraints, (NSUInteger)2, @"");
+  XCTAssertGreaterThan(footprint.constraintBytes, (size_t)0, @"");
+  XCTAssertGreaterThan(footprint.namedConstraintBytes, (size_t)0, @"");
+  XCTAssertEqual(footprint.registryBytes, (size_t)0, @"");
+  XCTAssertGreaterThan(ALKLayoutFootprintTotal(footprint), ALKLayoutFootprintTotal(empty), @"");
+  
+  // the child alone owns the width, the left edge is installed on the parent
+  ALKLayoutFootprint child = [childView alk_layoutFootprint];
+  XCTAssertEqual(child.constraints, (NSUInteger)1, @"");
+}
+
+- (void)testPoolSparesAreCounted
+{
+  UIView *view = [self newEmptyView];
+  
+  [ALKConstraints relayout:view do:^(ALKConstraints *c) {
+    [c set:ALKWidth to:10.f];
+    [c set:ALKHeight to:10.f];
+  }];
+  size_t inUse = [view alk_layoutFootprint].poolBytes;
+  
+  [ALKConstraints relayout:view do:^(ALKConstraints *c) {}];
+  
+  ALKLayoutFootprint footprint = [view alk_layoutFootprint];
+  XCTAssertEqual(footprint.constraints, (NSUInteger)0, @"");
+  XCTAssertGreaterThan(footprint.poolBytes, inUse, @"");
+}
+
+- (void)testProcessFootprintGrowsWithNamedConstraints
+{
+  ALKLayoutFootprint before = [UIView alk_processLayoutFootprint];
+  XCTAssertGreaterThan(before.registryBytes, (size_t)0, @"");
+  
+  NSMutableArray<UIView *> *views = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 50; i++) {
+    UIView *view = [self newEmptyView];
+    [ALKConstraints layout:view do:^(ALKConstraints *c) {
+      [c set:ALKWidth to:(CGFloat)i name:@"width"];
+    }];
+    [views addObject:view];
+  }
+  
+  ALKLayoutFootprint after = [UIView alk_processLayoutFootprint];
+  XCTAssertGreaterThanOrEqual(after.constraints, before.constraints + 50, @"");
+  XCTAssertGreaterThan(after.namedConstraintBytes, before.namedConstraintBytes, @"");
+  XCTAssertTrue([[UIView alk_viewsWithNamedConstraints] containsObject:[views lastObject]], @"");
+}
+
+@end
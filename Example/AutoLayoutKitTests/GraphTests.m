@@ -0,0 +1,143 @@
+//  GraphTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface GraphTests : ALKTestCase
+
+@end
+
+@implementation GraphTests
+
+- (void)testGraphHasNodesAndAnnotatedEdges
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c make:ALKLeft equalTo:parentView s:ALKLeft plus:5.f];
+    [c set:ALKWidth to:10.f name:@"width"];
+  }];
+  
+  ALKConstraintGraph *graph = [ALKConstraintGraph graphOfView:parentView measuringLayout:NO];
+  
+  XCTAssertEqual([graph.nodes count], (NSUInteger)2, @"");
+  XCTAssertEqual([graph.edges count], (NSUInteger)2, @"");
+  XCTAssertEqualWithAccuracy(graph.layoutTime, 0.0, 0.0001, @"");
+  
+  NSDictionary *parentNode = graph.nodes[0];
+  NSDictionary *childNode = graph.nodes[1];
+  XCTAssertEqualObjects(parentNode[@"degree"], @1, @"");
+  XCTAssertEqualObjects(childNode[@"degree"], @2, @"");
+  XCTAssertEqualObjects(childNode[@"installed"], @1, @"");
+  
+  NSDictionary *left = [[graph.edges filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"attribute == 'left'"]] firstObject];
+  XCTAssertEqualObjects(left[@"from"], childNode[@"id"], @"");
+  XCTAssertEqualObjects(left[@"to"], parentNode[@"id"], @"");
+  XCTAssertEqualObjects(left[@"relation"], @"==", @"");
+  XCTAssertEqualObjects(left[@"constant"], @5, @"");
+  XCTAssertNil(left[@"name"], @"");
+  
+  NSDictionary *width = [[graph.edges filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"attribute == 'width'"]] firstObject];
+  XCTAssertEqualObjects(width[@"from"], width[@"to"], @"");
+  XCTAssertEqualObjects(width[@"name"], @"width", @"");
+}
+
+- (void)testNamesRegisteredOnAncestorsAreFound
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  // installed on the child, registered on its parent
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c make:ALKWidth equalTo:nil s:ALKNone times:1.f plus:10.f on:parentView name:@"width"];
+  }];
+  
+  ALKConstraintGraph *graph = [ALKConstraintGraph graphOfView:childView measuringLayout:NO];
+  
+  XCTAssertEqual([graph.edges count], (NSUInteger)1, @"");
+  XCTAssertEqualObjects([graph.edges firstObject][@"name"], @"width", @"");
+}
+
+- (void)testExportingDoesNotCreateNameTables
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  UIView *rootView = [self newEmptyView];
+  [rootView addSubview:parentView];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c make:ALKLeft equalTo:parentView s:ALKLeft];
+  }];
+  
+  NSUInteger ownerCount = [[UIView alk_viewsWithNamedConstraints] count];
+  ALKConstraintGraph *graph = [ALKConstraintGraph graphOfView:parentView measuringLayout:NO];
+  
+  XCTAssertGreaterThan([graph.edges count], (NSUInteger)0, @"");
+  XCTAssertEqual([[UIView alk_viewsWithNamedConstraints] count], ownerCount, @"");
+  XCTAssertNil([rootView alk_existingNamedConstraints], @"");
+}
+
+- (void)testLayoutGuidesBecomeExternalNodes
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  UILayoutGuide *guide = [[UILayoutGuide alloc] init];
+  [parentView addLayoutGuide:guide];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c make:ALKTop equalTo:guide s:ALKTop];
+  }];
+  
+  ALKConstraintGraph *graph = [ALKConstraintGraph graphOfView:parentView measuringLayout:NO];
+  NSArray *external = [graph.nodes filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"external == YES"]];
+  
+  XCTAssertEqual([external count], (NSUInteger)1, @"");
+  XCTAssertEqualObjects([external firstObject][@"class"], NSStringFromClass([UILayoutGuide class]), @"");
+  XCTAssertEqualObjects([external firstObject][@"degree"], @1, @"");
+}
+
+- (void)testExports
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c alignAllEdgesTo:parentView];
+  }];
+  
+  ALKConstraintGraph *graph = [ALKConstraintGraph graphOfView:parentView measuringLayout:YES];
+  XCTAssertGreaterThan(graph.layoutTime, 0.0, @"");
+  
+  NSString *dot = graph.DOTRepresentation;
+  XCTAssertTrue([dot hasPrefix:@"digraph"], @"");
+  XCTAssertEqual([[dot componentsSeparatedByString:@" -> "] count], (NSUInteger)5, @"");
+  
+  NSDictionary *json = [NSJSONSerialization JSONObjectWithData:graph.JSONRepresentation options:0 error:NULL];
+  XCTAssertEqual([json[@"nodes"] count], (NSUInteger)2, @"");
+  XCTAssertEqual([json[@"edges"] count], (NSUInteger)4, @"");
+}
+
+@end
@@ -0,0 +1,215 @@
+//  PipelineTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface PipelineTests : ALKTestCase
+
+@property (nonatomic, strong) dispatch_queue_t buildQueue;
+@property (nonatomic, strong) ALKLayoutPipeline *pipeline;
+
+@end
+
+@implementation PipelineTests
+
+- (void)setUp
+{
+  [super setUp];
+  self.buildQueue = dispatch_queue_create("PipelineTests", DISPATCH_QUEUE_SERIAL);
+  self.pipeline = [[ALKLayoutPipeline alloc] initWithBuildQueue:self.buildQueue];
+}
+
+- (void)testNothingIsAppliedBeforeTheNextTick
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  [self.pipeline layout:childView do:^(ALKPreparedConstraints *c) {
+    [c set:ALKWidth to:10.f];
+  }];
+  [self.pipeline waitUntilBuilt];
+  
+  XCTAssertEqual(self.pipeline.pendingCount, (NSUInteger)1, @"");
+  XCTAssertEqual([childView.constraints count], (NSUInteger)0, @"");
+  
+  XCTAssertEqual([self.pipeline tick], (NSUInteger)1, @"");
+  
+  XCTAssertEqual(self.pipeline.pendingCount, (NSUInteger)0, @"");
+  XCTAssertEqual(self.pipeline.appliedFrameCount, (NSUInteger)1, @"");
+  XCTAssertEqual([childView.constraints count], (NSUInteger)1, @"");
+}
+
+- (void)testDisplayLinkIdlesWhileTheQueueIsEmpty
+{
+  UIView *view = [self newEmptyView];
+  
+  [self.pipeline start];
+  XCTAssertFalse(self.pipeline.ticking, @"");
+  
+  [self.pipeline layout:view do:^(ALKPreparedConstraints *c) {
+    [c set:ALKWidth to:10.f];
+  }];
+  XCTAssertTrue(self.pipeline.ticking, @"");
+  
+  [self.pipeline waitUntilBuilt];
+  [self.pipeline tick];
+  XCTAssertFalse(self.pipeline.ticking, @"");
+  
+  [self.pipeline stop];
+}
+
+- (void)testTickSolvesTheAppliedLayout
+{
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)];
+  UIView *childView = [self newEmptyView];
+  [parentView addSubview:childView];
+  
+  [self.pipeline layout:childView do:^(ALKPreparedConstraints *c) {
+    [c make:ALKLeft equalTo:parentView s:ALKLeft plus:10.f];
+    [c make:ALKTop equalTo:parentView s:ALKTop plus:20.f];
+    [c set:ALKWidth to:30.f];
+    [c set:ALKHeight to:30.f];
+  }];
+  [self.pipeline waitUntilBuilt];
+  [self.pipeline tick];
+  
+  XCTAssertTrue(CGRectEqualToRect(childView.frame, CGRectMake(10.f, 20.f, 30.f, 30.f)), @"%@", NSStringFromCGRect(childView.frame));
+}
+
+- (void)testStalledBuildsWaitForTheNextTick
+{
+  UIView *firstView = [self newEmptyView];
+  UIView *secondView = [self newEmptyView];
+  
+  // frame 1 is built, frame 2 is still building when the clock ticks
+  [self.pipeline layout:firstView do:^(ALKPreparedConstraints *c) {
+    [c set:ALKWidth to:10.f];
+  }];
+  [self.pipeline waitUntilBuilt];
+  
+  dispatch_suspend(self.buildQueue);
+  [self.pipeline layout:secondView do:^(ALKPreparedConstraints *c) {
+    [c set:ALKWidth to:20.f];
+  }];
+  
+  XCTAssertEqual([self.pipeline tick], (NSUInteger)1, @"");
+  XCTAssertEqual([firstView.constraints count], (NSUInteger)1, @"");
+  XCTAssertEqual([secondView.constraints count], (NSUInteger)0, @"");
+  
+  XCTAssertEqual([self.pipeline tick], (NSUInteger)0, @"");
+  XCTAssertEqual(self.pipeline.appliedFrameCount, (NSUInteger)1, @"");
+  
+  dispatch_resume(self.buildQueue);
+  [self.pipeline waitUntilBuilt];
+  
+  XCTAssertEqual([self.pipeline tick], (NSUInteger)1, @"");
+  XCTAssertEqual([secondView.constraints count], (NSUInteger)1, @"");
+  XCTAssertEqual(self.pipeline.appliedFrameCount, (NSUInteger)2, @"");
+}
+
+- (void)testBlocksAreAppliedInSubmissionOrder
+{
+  UIView *view = [self newEmptyView];
+  
+  for (NSUInteger i = 1; i <= 3; i++) {
+    [self.pipeline layout:view do:^(ALKPreparedConstraints *c) {
+      [c set:ALKWidth to:(CGFloat)i name:@"width"];
+    }];
+  }
+  [self.pipeline waitUntilBuilt];
+  [self.pipeline tick];
+  
+  // named constraints keep the first one, so the first submitted block must win
+  XCTAssertEqualWithAccuracy([view alk_constraintWithName:@"width"].constant, 1.f, 0.001, @"");
+}
+
+- (void)testTickStopsAtTheDeadline
+{
+  // every reading of the clock advances it by one millisecond
+  __block CFTimeInterval now = 0;
+  self.pipeline.clock = ^CFTimeInterval {
+    now += 0.001;
+    return now;
+  };
+  
+  NSMutableArray<UIView *> *views = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 10; i++) {
+    UIView *view = [self newEmptyView];
+    [views addObject:view];
+    [self.pipeline layout:view do:^(ALKPreparedConstraints *c) {
+      [c set:ALKWidth to:10.f];
+      [c set:ALKHeight to:10.f];
+    }];
+  }
+  [self.pipeline waitUntilBuilt];
+  
+  // start at 1ms, then one reading before each builder after the first
+  NSUInteger applied = [self.pipeline tickWithDeadline:0.0045];
+  XCTAssertEqual(applied, (NSUInteger)4, @"");
+  XCTAssertEqual(self.pipeline.pendingCount, (NSUInteger)6, @"");
+  
+  [views enumerateObjectsUsingBlock:^(UIView *view, NSUInteger idx, BOOL *stop) {
+    // builders are applied as a whole or not at all
+    XCTAssertEqual([view.constraints count], (NSUInteger)(idx < applied ? 2 : 0), @"");
+  }];
+  
+  while (self.pipeline.pendingCount > 0) {
+    XCTAssertGreaterThan([self.pipeline tickWithDeadline:now], (NSUInteger)0, @"");
+  }
+  XCTAssertEqual([[views lastObject].constraints count], (NSUInteger)2, @"");
+}
+
+- (void)testWorstCaseSliceLength
+{
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 10000.f)];
+  UIView *previous = parentView;
+  
+  for (NSUInteger i = 0; i < 500; i++) {
+    UIView *view = [self newEmptyView];
+    [parentView addSubview:view];
+    
+    UIView *above = previous;
+    [self.pipeline layout:view do:^(ALKPreparedConstraints *c) {
+      [c make:ALKTop equalTo:above s:(above == parentView ? ALKTop : ALKBottom) plus:2.f];
+      [c make:ALKLeft equalTo:parentView s:ALKLeft];
+      [c make:ALKWidth equalTo:parentView s:ALKWidth];
+      [c set:ALKHeight to:16.f];
+    }];
+    previous = view;
+  }
+  [self.pipeline waitUntilBuilt];
+  
+  CFTimeInterval budget = 0.004;
+  NSUInteger ticks = 0;
+  while (self.pipeline.pendingCount > 0) {
+    [self.pipeline tickWithDeadline:self.pipeline.clock() + budget];
+    ticks++;
+  }
+  
+  XCTAssertEqual(self.pipeline.appliedFrameCount, ticks, @"");
+  XCTAssertEqualWithAccuracy(CGRectGetMaxY(previous.frame), 500.f * 18.f, 0.001, @"");
+}
+
+@end
@@ -0,0 +1,207 @@
+//  PoolTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface PoolTests : ALKTestCase
+
+@end
+
+@implementation PoolTests
+
+- (void)setUp
+{
+  [super setUp];
+  [[ALKConstraintPool sharedPool] resetStatistics];
+}
+
+- (void)configureView:(UIView *)view withHeight:(CGFloat)height
+{
+  [ALKConstraints relayout:view do:^(ALKConstraints *c) {
+    [c make:ALKLeft equalTo:view.superview s:ALKLeft];
+    [c make:ALKRight equalTo:view.superview s:ALKRight];
+    [c set:ALKHeight to:height];
+  }];
+}
+
+- (void)testRelayoutReusesMatchingConstraints
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  ALKConstraintPool *pool = [ALKConstraintPool sharedPool];
+  
+  [self configureView:childView withHeight:10.f];
+  NSLayoutConstraint *height = [childView.constraints firstObject];
+  XCTAssertEqual(pool.missCount, (NSUInteger)3, @"");
+  
+  [self configureView:childView withHeight:20.f];
+  XCTAssertEqual(pool.hitCount, (NSUInteger)3, @"");
+  XCTAssertEqualWithAccuracy(pool.hitRate, 0.5, 0.001, @"");
+  
+  XCTAssertEqual([childView.constraints count], (NSUInteger)1, @"");
+  XCTAssertEqual([parentView.constraints count], (NSUInteger)2, @"");
+  XCTAssertEqual([childView.constraints firstObject], height, @"");
+  XCTAssertEqualWithAccuracy(height.constant, 20.f, 0.001, @"");
+}
+
+- (void)testRelayoutDeactivatesConstraintsThatAreNotDeclaredAgain
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  ALKConstraintPool *pool = [ALKConstraintPool sharedPool];
+  
+  [self configureView:childView withHeight:10.f];
+  
+  [ALKConstraints relayout:childView do:^(ALKConstraints *c) {
+    [c set:ALKWidth to:10.f];
+  }];
+  
+  XCTAssertEqual([parentView.constraints count], (NSUInteger)0, @"");
+  XCTAssertEqual([childView.constraints count], (NSUInteger)1, @"");
+  XCTAssertGreaterThanOrEqual(pool.spareCount, (NSUInteger)3, @"");
+  
+  // switching back reactivates the spares
+  [pool resetStatistics];
+  [self configureView:childView withHeight:30.f];
+  XCTAssertEqual(pool.hitCount, (NSUInteger)3, @"");
+  XCTAssertEqual(pool.missCount, (NSUInteger)0, @"");
+  XCTAssertEqual([parentView.constraints count], (NSUInteger)2, @"");
+}
+
+- (void)testRelayoutActivatesAfterDeactivatingLeftovers
+{
+  UIView *view = [self newEmptyView];
+  
+  [ALKConstraints relayout:view do:^(ALKConstraints *c) {
+    [c set:ALKWidth to:10.f];
+  }];
+  NSLayoutConstraint *oldWidth = [view.constraints firstObject];
+  
+  __block NSLayoutConstraint *newWidth = nil;
+  [ALKConstraints relayout:view do:^(ALKConstraints *c) {
+    newWidth = [c make:ALKWidth greaterThan:nil s:ALKNone times:1.f plus:20.f on:view];
+    
+    // the required width of 10 is still active here
+    XCTAssertTrue(oldWidth.active, @"");
+    XCTAssertFalse(newWidth.active, @"");
+  }];
+  
+  XCTAssertFalse(oldWidth.active, @"");
+  XCTAssertTrue(newWidth.active, @"");
+  XCTAssertEqual([view.constraints count], (NSUInteger)1, @"");
+}
+
+- (void)testRequiredConstraintsAreNotReusedAsOptional
+{
+  UIView *view = [self newEmptyView];
+  
+  [ALKConstraints relayout:view do:^(ALKConstraints *c) {
+    [c set:ALKHeight to:10.f];
+  }];
+  
+  [ALKConstraints relayout:view do:^(ALKConstraints *c) {
+    [c setPriorityDefaultHigh];
+    [c set:ALKHeight to:10.f];
+  }];
+  
+  XCTAssertEqual([ALKConstraintPool sharedPool].hitCount, (NSUInteger)0, @"");
+  XCTAssertEqual([view.constraints count], (NSUInteger)1, @"");
+  XCTAssertEqualWithAccuracy([[view.constraints firstObject] priority], UILayoutPriorityDefaultHigh, 0.001, @"");
+}
+
+- (void)testPurgeDropsSpares
+{
+  UIView *view = [self newEmptyView];
+  ALKConstraintPool *pool = [ALKConstraintPool sharedPool];
+  
+  [ALKConstraints relayout:view do:^(ALKConstraints *c) {
+    [c set:ALKHeight to:10.f];
+  }];
+  [ALKConstraints relayout:view do:^(ALKConstraints *c) {}];
+  XCTAssertGreaterThan(pool.spareCount, (NSUInteger)0, @"");
+  
+  [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+  XCTAssertEqual(pool.spareCount, (NSUInteger)0, @"");
+}
+
+- (void)testSparesAreReleasedWithTheirView
+{
+  ALKConstraintPool *pool = [ALKConstraintPool sharedPool];
+  NSUInteger spareCount = pool.spareCount;
+  __weak NSLayoutConstraint *spare = nil;
+  
+  @autoreleasepool {
+    UIView *cell = [self newEmptyView];
+    [ALKConstraints relayout:cell do:^(ALKConstraints *c) {
+      [c set:ALKHeight to:10.f];
+    }];
+    spare = [cell.constraints firstObject];
+    [ALKConstraints relayout:cell do:^(ALKConstraints *c) {}];
+    
+    XCTAssertEqual(pool.spareCount, spareCount + 1, @"");
+  }
+  
+  XCTAssertNil(spare, @"");
+  XCTAssertEqual(pool.spareCount, spareCount, @"");
+}
+
+- (void)testHeterogeneousFeedHitRate
+{
+  UIView *feedView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+  NSMutableArray<UIView *> *cells = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 10; i++) {
+    UIView *cell = [self newEmptyView];
+    [feedView addSubview:cell];
+    [cells addObject:cell];
+  }
+  
+  ALKConstraintPool *pool = [ALKConstraintPool sharedPool];
+  
+  for (NSUInteger row = 0; row < 2000; row++) {
+    UIView *cell = cells[row % cells.count];
+    CGFloat height = 40.f + (CGFloat)(row % 7);
+    
+    [ALKConstraints relayout:cell do:^(ALKConstraints *c) {
+      [c make:ALKLeft equalTo:feedView s:ALKLeft];
+      [c make:ALKWidth equalTo:feedView s:ALKWidth];
+      if (row % 3 == 0) {
+        // an image cell
+        [c make:ALKHeight equalTo:feedView s:ALKWidth times:0.75f];
+      } else {
+        [c set:ALKHeight to:height];
+      }
+    }];
+  }
+  
+  XCTAssertGreaterThan(pool.hitRate, 0.9, @"");
+  
+  NSUInteger activeCount = [feedView.constraints count];
+  for (UIView *cell in cells) {
+    activeCount += [cell.constraints count];
+  }
+  XCTAssertEqual(activeCount, cells.count * 3, @"");
+}
+
+@end
@@ -0,0 +1,128 @@
+//  PrecomputedLayoutTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface PrecomputedLayoutTests : ALKTestCase
+
+@property (nonatomic, strong) NSArray<NSValue *> *sizes;
+
+@end
+
+@implementation PrecomputedLayoutTests
+
+- (void)setUp
+{
+  [super setUp];
+  
+  self.sizes = @[ [NSValue valueWithCGSize:CGSizeMake(320.f, 480.f)],
+                  [NSValue valueWithCGSize:CGSizeMake(768.f, 1024.f)] ];
+}
+
+- (void)tearDown
+{
+  self.sizes = nil;
+  
+  [super tearDown];
+}
+
+- (UIView *)newContainerWithConstraints:(BOOL)constrained
+{
+  UIView *container = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+  UIView *header = [[UIView alloc] initWithFrame:CGRectZero];
+  UIView *content = [[UIView alloc] initWithFrame:CGRectZero];
+  [container addSubview:header];
+  [container addSubview:content];
+  
+  if (constrained) {
+    [ALKConstraints layout:header do:^(ALKConstraints *c) {
+      [c make:ALKTop equalTo:container s:ALKTop];
+      [c make:ALKLeft equalTo:container s:ALKLeft];
+      [c make:ALKRight equalTo:container s:ALKRight];
+      [c set:ALKHeight to:44.f];
+    }];
+    [ALKConstraints layout:content do:^(ALKConstraints *c) {
+      [c make:ALKTop equalTo:header s:ALKBottom plus:10.f];
+      [c make:ALKCenterX equalTo:container s:ALKCenterX];
+      [c make:ALKWidth equalTo:container s:ALKWidth times:0.5f];
+      [c make:ALKBottom equalTo:container s:ALKBottom];
+    }];
+  }
+  
+  return container;
+}
+
+- (void)testAppliesSolvedFrames
+{
+  UIView *solved = [self newContainerWithConstraints:YES];
+  ALKPrecomputedLayout *layout = [ALKPrecomputedLayout precomputedLayoutOfView:solved sizes:self.sizes];
+  XCTAssertEqual(layout.viewCount, (NSUInteger)2, @"");
+  XCTAssertEqual(solved.bounds.size.width, 320.f, @"");
+  
+  UIView *container = [self newContainerWithConstraints:NO];
+  container.bounds = CGRectMake(0.f, 0.f, 768.f, 1024.f);
+  XCTAssertTrue([layout applyToView:container], @"");
+  
+  UIView *content = container.subviews[1];
+  XCTAssertTrue(CGRectEqualToRect(content.frame, CGRectMake(192.f, 54.f, 384.f, 970.f)), @"");
+  XCTAssertTrue(CGRectEqualToRect([container.subviews[0] frame], CGRectMake(0.f, 0.f, 768.f, 44.f)), @"");
+}
+
+- (void)testUnknownSizeIsNotApplied
+{
+  ALKPrecomputedLayout *layout = [ALKPrecomputedLayout precomputedLayoutOfView:[self newContainerWithConstraints:YES] sizes:self.sizes];
+  
+  UIView *container = [self newContainerWithConstraints:NO];
+  container.bounds = CGRectMake(0.f, 0.f, 375.f, 667.f);
+  XCTAssertFalse([layout applyToView:container], @"");
+  XCTAssertTrue(CGRectEqualToRect([container.subviews[0] frame], CGRectZero), @"");
+}
+
+- (void)testDifferentSubtreeIsNotApplied
+{
+  ALKPrecomputedLayout *layout = [ALKPrecomputedLayout precomputedLayoutOfView:[self newContainerWithConstraints:YES] sizes:self.sizes];
+  
+  UIView *container = [self newContainerWithConstraints:NO];
+  [container addSubview:[[UIView alloc] initWithFrame:CGRectZero]];
+  XCTAssertFalse([layout applyToView:container], @"");
+}
+
+- (void)testDataRepresentationRoundTrip
+{
+  ALKPrecomputedLayout *layout = [ALKPrecomputedLayout precomputedLayoutOfView:[self newContainerWithConstraints:YES] sizes:self.sizes];
+  ALKPrecomputedLayout *loaded = [ALKPrecomputedLayout precomputedLayoutWithData:layout.dataRepresentation];
+  
+  XCTAssertNotNil(loaded, @"");
+  XCTAssertEqualObjects(loaded.sizes, layout.sizes, @"");
+  XCTAssertEqual(loaded.viewCount, layout.viewCount, @"");
+  
+  UIView *container = [self newContainerWithConstraints:NO];
+  XCTAssertTrue([loaded applyToView:container], @"");
+  XCTAssertTrue(CGRectEqualToRect([container.subviews[1] frame], CGRectMake(80.f, 54.f, 160.f, 426.f)), @"");
+  
+  XCTAssertNil([ALKPrecomputedLayout precomputedLayoutWithData:[@"invalid" dataUsingEncoding:NSUTF8StringEncoding]], @"");
+}
+
+@end
@@ -0,0 +1,175 @@
+//  PrepareTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+static NSUInteger const kALKPrepareStressViews = 64;
+static NSUInteger const kALKPrepareStressConstraints = 32;
+
+@interface PrepareTests : ALKTestCase
+
+@end
+
+@implementation PrepareTests
+
+- (void)testPreparingDoesNotTouchTheView
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  ALKPreparedConstraints *prepared = [ALKConstraints prepare:childView do:^(ALKPreparedConstraints *c) {
+    [c make:ALKWidth equalTo:parentView s:ALKWidth];
+  }];
+  
+  XCTAssertTrue(childView.translatesAutoresizingMaskIntoConstraints, @"");
+  XCTAssertFalse([prepared isCommitted], @"");
+  XCTAssertEqual([parentView.constraints count], (NSUInteger)0, @"");
+  
+  NSArray *constraints = [prepared commit];
+  
+  XCTAssertTrue([prepared isCommitted], @"");
+  XCTAssertFalse(childView.translatesAutoresizingMaskIntoConstraints, @"");
+  XCTAssertEqual([constraints count], (NSUInteger)1, @"");
+  XCTAssertTrue([constraints.firstObject isActive], @"");
+  XCTAssertEqual([parentView.constraints count], (NSUInteger)1, @"");
+}
+
+- (void)testCommitResolvesTargetsAndNames
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  ALKPreparedConstraints *prepared = [ALKConstraints prepare:childView do:^(ALKPreparedConstraints *c) {
+    [c set:ALKHeight to:10.f name:@"height"];
+    [c make:ALKLeft equalTo:parentView s:ALKLeft times:1.f plus:5.f on:parentView name:@"left"];
+  }];
+  
+  XCTAssertNil([childView alk_constraintWithName:@"height"], @"");
+  XCTAssertNil([parentView alk_constraintWithName:@"left"], @"");
+  
+  [prepared commit];
+  
+  [self checkConstraint:[childView alk_constraintWithName:@"height"]
+               withItem:childView
+              attribute:NSLayoutAttributeHeight
+              relatedBy:NSLayoutRelationEqual
+                 toItem:nil
+              attribute:NSLayoutAttributeNotAnAttribute
+             multiplier:1.f
+               constant:10.f];
+  
+  [self checkConstraint:[parentView alk_constraintWithName:@"left"]
+               withItem:childView
+              attribute:NSLayoutAttributeLeft
+              relatedBy:NSLayoutRelationEqual
+                 toItem:parentView
+              attribute:NSLayoutAttributeLeft
+             multiplier:1.f
+               constant:5.f];
+}
+
+- (void)testCommitKeepsRelationsAndPriorities
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  ALKPreparedConstraints *prepared = [ALKConstraints prepare:childView do:^(ALKPreparedConstraints *c) {
+    [c setPriority:UILayoutPriorityDefaultHigh];
+    [c make:ALKWidth lessThan:parentView s:ALKWidth times:0.5f plus:0.f on:nil name:@"width"];
+  }];
+  
+  NSArray<NSLayoutConstraint *> *constraints = [prepared commit];
+  NSLayoutConstraint *width = [parentView alk_constraintWithName:@"width"];
+  
+  XCTAssertEqual(constraints.firstObject, width, @"");
+  XCTAssertEqual(width.relation, NSLayoutRelationLessThanOrEqual, @"");
+  XCTAssertEqualWithAccuracy(width.multiplier, 0.5f, 0.001, @"");
+  XCTAssertEqualWithAccuracy(width.priority, UILayoutPriorityDefaultHigh, 0.001, @"");
+}
+
+- (void)testCommitTwiceDoesNothing
+{
+  UIView *view = [self newEmptyView];
+  
+  ALKPreparedConstraints *prepared = [ALKConstraints prepare:view do:^(ALKPreparedConstraints *c) {
+    [c set:ALKWidth to:10.f];
+  }];
+  
+  [prepared commit];
+  XCTAssertEqual([[prepared commit] count], (NSUInteger)0, @"");
+  
+  XCTAssertEqual([view.constraints count], (NSUInteger)1, @"");
+}
+
+- (void)testPreparingConcurrentlyOnBackgroundQueues
+{
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+  NSMutableArray<UIView *> *views = [NSMutableArray array];
+  
+  for (NSUInteger i = 0; i < kALKPrepareStressViews; i++) {
+    UIView *view = [self newEmptyView];
+    [parentView addSubview:view];
+    [views addObject:view];
+  }
+  
+  NSMutableArray *prepared = [NSMutableArray arrayWithCapacity:kALKPrepareStressViews];
+  for (NSUInteger i = 0; i < kALKPrepareStressViews; i++) {
+    [prepared addObject:[NSNull null]];
+  }
+  
+  NSArray<UIView *> *immutableViews = [views copy];
+  dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+  NSLock *lock = [[NSLock alloc] init];
+  
+  dispatch_apply(kALKPrepareStressViews, queue, ^(size_t i) {
+    UIView *view = immutableViews[i];
+    UIView *previous = (i > 0) ? immutableViews[i - 1] : parentView;
+    
+    ALKPreparedConstraints *c = [ALKConstraints prepare:view do:^(ALKPreparedConstraints *c) {
+      for (NSUInteger j = 0; j < kALKPrepareStressConstraints; j++) {
+        [c setPriority:(UILayoutPriority)(1 + j)];
+        [c make:ALKTop equalTo:previous s:ALKTop plus:(CGFloat)j];
+      }
+      [c setPriority:UILayoutPriorityRequired];
+      [c set:ALKWidth to:(CGFloat)i name:@"width"];
+    }];
+    
+    [lock lock];
+    prepared[i] = c;
+    [lock unlock];
+  });
+  
+  for (ALKPreparedConstraints *c in prepared) {
+    [c commit];
+  }
+  
+  XCTAssertEqual([parentView.constraints count], kALKPrepareStressViews * kALKPrepareStressConstraints, @"");
+  
+  [immutableViews enumerateObjectsUsingBlock:^(UIView *view, NSUInteger idx, BOOL *stop) {
+    XCTAssertEqualWithAccuracy([view alk_constraintWithName:@"width"].constant, (CGFloat)idx, 0.001, @"");
+  }];
+}
+
+@end
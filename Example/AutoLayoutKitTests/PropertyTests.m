@@ -0,0 +1,301 @@
+//  PropertyTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+/// Every generated case can be reproduced by running with the same seed, e.g.
+/// `ALK_PROPERTY_SEED=42 rake test`.
+static uint64_t const kALKPropertyDefaultSeed   = 0x5eed5eedULL;
+static NSUInteger const kALKPropertyDefaultCases = 200;
+
+static CGFloat const kALKPropertyRootSize = 1024.f;
+
+#pragma mark - Random Numbers
+
+typedef struct {
+  uint64_t state;
+} ALKRandom;
+
+static uint64_t ALKRandomNext(ALKRandom *random)
+{
+  // xorshift64*
+  uint64_t x = random->state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  random->state = x;
+  return x * 0x2545F4914F6CDD1DULL;
+}
+
+static NSUInteger ALKRandomIndex(ALKRandom *random, NSUInteger count)
+{
+  return (NSUInteger)(ALKRandomNext(random) % count);
+}
+
+static CGFloat ALKRandomValue(ALKRandom *random, NSUInteger max)
+{
+  // multiples of 4 stay exact after pixel snapping on every screen scale
+  return (CGFloat)(ALKRandomIndex(random, max / 4 + 1) * 4);
+}
+
+#pragma mark - Reference Layout
+
+/// One axis of a generated view: which edge is pinned to the parent or, for
+/// chained views, to the opposite edge of the previous sibling, the size
+/// relation and the values needed to compute the expected frame by hand.
+typedef struct {
+  ALKAttribute edge;
+  ALKAttribute relatedEdge;
+  BOOL chained;
+  CGFloat offset;
+  ALKRelation sizeRelation;
+  CGFloat requiredSize;
+  CGFloat preferredSize;
+} ALKAxisSpec;
+
+static CGFloat ALKExpectedSize(ALKAxisSpec spec)
+{
+  switch (spec.sizeRelation) {
+    case ALKEqualTo:      return spec.requiredSize;
+    case ALKLessThan:     return MIN(spec.requiredSize, spec.preferredSize);
+    case ALKGreaterThan:  return MAX(spec.requiredSize, spec.preferredSize);
+  }
+  return spec.requiredSize;
+}
+
+static CGFloat ALKExpectedOrigin(ALKAxisSpec spec, CGFloat parentSize, CGFloat previousOrigin, CGFloat previousSize)
+{
+  CGFloat size = ALKExpectedSize(spec);
+  
+  if (spec.chained) {
+    switch (spec.edge) {
+      case ALKLeft:
+      case ALKLeading:
+      case ALKTop:    return previousOrigin + previousSize + spec.offset;
+      default:        return previousOrigin - spec.offset - size;
+    }
+  }
+  
+  switch (spec.edge) {
+    case ALKLeft:
+    case ALKLeading:
+    case ALKTop:      return spec.offset;
+    case ALKRight:
+    case ALKTrailing:
+    case ALKBottom:   return parentSize - size - spec.offset;
+    case ALKCenterX:
+    case ALKCenterY:  return (parentSize - size) / 2.f + spec.offset;
+    default:          return 0.f;
+  }
+}
+
+@interface PropertyTests : ALKTestCase
+
+@property (nonatomic, strong) NSMutableArray<NSValue *> *expectedFrames;
+@property (nonatomic, strong) NSMutableArray<UIView *> *generatedViews;
+
+@end
+
+@implementation PropertyTests
+
+#pragma mark - Configuration
+
+- (uint64_t)seed
+{
+  NSString *seed = [[NSProcessInfo processInfo] environment][@"ALK_PROPERTY_SEED"];
+  return seed ? (uint64_t)[seed longLongValue] : kALKPropertyDefaultSeed;
+}
+
+- (NSUInteger)numberOfCases
+{
+  NSString *cases = [[NSProcessInfo processInfo] environment][@"ALK_PROPERTY_CASES"];
+  return cases ? (NSUInteger)[cases integerValue] : kALKPropertyDefaultCases;
+}
+
+#pragma mark - Generators
+
+- (ALKAxisSpec)axisWithEdges:(NSArray *)edges parentSize:(CGFloat)parentSize random:(ALKRandom *)random
+{
+  ALKAxisSpec spec;
+  spec.edge           = (ALKAttribute)[edges[ALKRandomIndex(random, edges.count)] integerValue];
+  spec.sizeRelation   = (ALKRelation)((NSInteger)ALKRandomIndex(random, 3) - 1);
+  spec.requiredSize   = ALKRandomValue(random, (NSUInteger)(parentSize / 2.f));
+  spec.preferredSize  = ALKRandomValue(random, (NSUInteger)(parentSize / 2.f));
+  spec.offset         = ALKRandomValue(random, (NSUInteger)(parentSize / 4.f));
+  spec.relatedEdge    = spec.edge;
+  spec.chained        = NO;
+  
+  if (spec.edge == ALKCenterX || spec.edge == ALKCenterY) {
+    spec.offset = 0.f;
+  }
+  
+  return spec;
+}
+
+- (ALKAxisSpec)chainAxis:(ALKAxisSpec)spec pairs:(NSArray *)pairs random:(ALKRandom *)random
+{
+  // each pair is { edge of the view, edge of the previous sibling }
+  NSArray *pair     = pairs[ALKRandomIndex(random, pairs.count)];
+  spec.edge         = (ALKAttribute)[pair[0] integerValue];
+  spec.relatedEdge  = (ALKAttribute)[pair[1] integerValue];
+  spec.chained      = YES;
+  return spec;
+}
+
+- (void)layoutAxis:(ALKAxisSpec)spec
+      sizeAttribute:(ALKAttribute)sizeAttribute
+               view:(UIView *)view
+             parent:(UIView *)parent
+            sibling:(UIView *)sibling
+        constraints:(ALKConstraints *)c
+{
+  NSLayoutConstraint *constraint = nil;
+  UIView *relatedView = spec.chained ? sibling : parent;
+  
+  // position
+  constraint = [c make:spec.edge equalTo:relatedView s:spec.relatedEdge times:1.f plus:[self signedOffset:spec] on:parent];
+  [self checkConstraint:constraint withItem:view attribute:(NSLayoutAttribute)spec.edge relatedBy:NSLayoutRelationEqual
+                 toItem:relatedView attribute:(NSLayoutAttribute)spec.relatedEdge multiplier:1.f constant:[self signedOffset:spec]];
+  
+  // size
+  switch (spec.sizeRelation) {
+    case ALKEqualTo:
+      constraint = [c set:sizeAttribute to:spec.requiredSize];
+      break;
+    case ALKLessThan:
+      constraint = [c make:sizeAttribute lessThan:nil s:ALKNone times:1.f plus:spec.requiredSize on:view];
+      break;
+    case ALKGreaterThan:
+      constraint = [c make:sizeAttribute greaterThan:nil s:ALKNone times:1.f plus:spec.requiredSize on:view];
+      break;
+  }
+  [self checkConstraint:constraint withItem:view attribute:(NSLayoutAttribute)sizeAttribute relatedBy:(NSLayoutRelation)spec.sizeRelation
+                 toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.f constant:spec.requiredSize];
+  
+  if (spec.sizeRelation != ALKEqualTo) {
+    [c setPriorityDefaultLow];
+    [c set:sizeAttribute to:spec.preferredSize];
+    [c setPriorityRequired];
+  }
+}
+
+- (CGFloat)signedOffset:(ALKAxisSpec)spec
+{
+  switch (spec.edge) {
+    case ALKRight:
+    case ALKTrailing:
+    case ALKBottom:   return (-1) * spec.offset;
+    default:          return spec.offset;
+  }
+}
+
+- (void)generateChildrenOf:(UIView *)parent
+               parentSize:(CGSize)parentSize
+                    depth:(NSUInteger)depth
+                   random:(ALKRandom *)random
+{
+  if (depth == 0) return;
+  
+  NSArray *horizontalEdges  = @[@(ALKLeft), @(ALKRight), @(ALKLeading), @(ALKTrailing), @(ALKCenterX)];
+  NSArray *verticalEdges    = @[@(ALKTop), @(ALKBottom), @(ALKCenterY)];
+  NSArray *horizontalChains = @[@[@(ALKLeft), @(ALKRight)], @[@(ALKLeading), @(ALKTrailing)], @[@(ALKRight), @(ALKLeft)]];
+  NSArray *verticalChains   = @[@[@(ALKTop), @(ALKBottom)], @[@(ALKBottom), @(ALKTop)]];
+  NSUInteger children       = ALKRandomIndex(random, 4);
+  
+  UIView *previous = nil;
+  CGRect previousFrame = CGRectZero;
+  
+  for (NSUInteger i = 0; i < children; i++) {
+    UIView *view = [self newEmptyView];
+    [parent addSubview:view];
+    
+    ALKAxisSpec horizontal  = [self axisWithEdges:horizontalEdges parentSize:parentSize.width random:random];
+    ALKAxisSpec vertical    = [self axisWithEdges:verticalEdges parentSize:parentSize.height random:random];
+    
+    // siblings are chained to the previous one on either axis, so relations between siblings are covered too
+    if (previous && ALKRandomIndex(random, 2) == 0) {
+      horizontal = [self chainAxis:horizontal pairs:horizontalChains random:random];
+    }
+    if (previous && ALKRandomIndex(random, 2) == 0) {
+      vertical = [self chainAxis:vertical pairs:verticalChains random:random];
+    }
+    
+    UIView *sibling = previous;
+    [ALKConstraints layout:view do:^(ALKConstraints *c) {
+      [self layoutAxis:horizontal sizeAttribute:ALKWidth view:view parent:parent sibling:sibling constraints:c];
+      [self layoutAxis:vertical sizeAttribute:ALKHeight view:view parent:parent sibling:sibling constraints:c];
+    }];
+    
+    CGRect frame = CGRectMake(ALKExpectedOrigin(horizontal, parentSize.width, CGRectGetMinX(previousFrame), CGRectGetWidth(previousFrame)),
+                              ALKExpectedOrigin(vertical, parentSize.height, CGRectGetMinY(previousFrame), CGRectGetHeight(previousFrame)),
+                              ALKExpectedSize(horizontal),
+                              ALKExpectedSize(vertical));
+    
+    [self.generatedViews addObject:view];
+    [self.expectedFrames addObject:[NSValue valueWithCGRect:frame]];
+    previous = view;
+    previousFrame = frame;
+    
+    [self generateChildrenOf:view parentSize:frame.size depth:(depth - 1) random:random];
+  }
+}
+
+#pragma mark - Properties
+
+- (void)testRandomLayoutsMatchTheReferenceLayout
+{
+  uint64_t seed = [self seed];
+  NSUInteger cases = [self numberOfCases];
+  
+  for (NSUInteger i = 0; i < cases; i++) {
+    ALKRandom random = { .state = seed + i * 0x9E3779B97F4A7C15ULL };
+    if (random.state == 0) random.state = 1;
+    
+    self.expectedFrames = [NSMutableArray array];
+    self.generatedViews = [NSMutableArray array];
+    
+    UIView *root = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, kALKPropertyRootSize, kALKPropertyRootSize)];
+    [self generateChildrenOf:root
+                  parentSize:root.bounds.size
+                       depth:(1 + ALKRandomIndex(&random, 4))
+                      random:&random];
+    
+    [root layoutIfNeeded];
+    
+    [self.generatedViews enumerateObjectsUsingBlock:^(UIView *view, NSUInteger idx, BOOL *stop) {
+      CGRect expected = [self.expectedFrames[idx] CGRectValue];
+      BOOL matches = fabs(view.frame.origin.x - expected.origin.x) <= 1.f
+                  && fabs(view.frame.origin.y - expected.origin.y) <= 1.f
+                  && fabs(view.frame.size.width - expected.size.width) <= 1.f
+                  && fabs(view.frame.size.height - expected.size.height) <= 1.f;
+      
+      XCTAssertTrue(matches, @"seed=%llu case=%lu view=%lu expected %@, got %@",
+                    seed, (unsigned long)i, (unsigned long)idx,
+                    NSStringFromCGRect(expected), NSStringFromCGRect(view.frame));
+    }];
+  }
+}
+
+@end
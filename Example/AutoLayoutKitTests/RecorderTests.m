@@ -0,0 +1,204 @@
+//  RecorderTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+NSString * const kALKRecorderTestConstraint = @"ALKRecorderTestConstraint";
+
+@interface RecorderTests : ALKTestCase
+
+@end
+
+@implementation RecorderTests
+
+- (void)tearDown
+{
+  [[ALKLayoutRecorder activeRecorder] stopRecording];
+  [super tearDown];
+}
+
+- (void)testRecordingIsOffByDefault
+{
+  XCTAssertNil([ALKLayoutRecorder activeRecorder], @"");
+}
+
+- (void)testStopRecordingTurnsRecordingOff
+{
+  ALKLayoutRecorder *recorder = [ALKLayoutRecorder startRecording];
+  XCTAssertEqual([ALKLayoutRecorder activeRecorder], recorder, @"");
+  
+  [recorder stopRecording];
+  XCTAssertNil([ALKLayoutRecorder activeRecorder], @"");
+}
+
+- (void)testRecordsEveryOperation
+{
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  ALKLayoutRecorder *recorder = [ALKLayoutRecorder startRecording];
+  NSUInteger length = recorder.data.length;
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c make:ALKLeft equalTo:parentView s:ALKLeft];
+  }];
+  XCTAssertGreaterThan(recorder.data.length, length, @"");
+  length = recorder.data.length;
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c set:ALKWidth to:10.f name:kALKRecorderTestConstraint];
+  }];
+  XCTAssertGreaterThan(recorder.data.length, length, @"");
+  length = recorder.data.length;
+  
+  [childView alk_setConstant:20.f forConstraintWithName:kALKRecorderTestConstraint];
+  XCTAssertGreaterThan(recorder.data.length, length, @"");
+  length = recorder.data.length;
+  
+  [childView alk_removeConstraintWithName:kALKRecorderTestConstraint];
+  XCTAssertGreaterThan(recorder.data.length, length, @"");
+  
+  [recorder stopRecording];
+}
+
+- (void)testReplayRebuildsTheRecordedLayout
+{
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+  UIView *childView = [self newEmptyView];
+  [parentView addSubview:childView];
+  
+  ALKLayoutRecorder *recorder = [ALKLayoutRecorder startRecording];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c make:ALKTop equalTo:parentView s:ALKTop];
+    [c make:ALKLeft equalTo:parentView s:ALKLeft];
+    [c set:ALKWidth to:100.f name:kALKRecorderTestConstraint];
+    [c setPriorityDefaultHigh];
+    [c set:ALKHeight to:50.f];
+  }];
+  
+  [childView alk_setConstant:150.f forConstraintWithName:kALKRecorderTestConstraint];
+  
+  NSData *session = [recorder stopRecording];
+  ALKLayoutReplayResult result = [ALKLayoutRecorder replay:session];
+  
+  XCTAssertTrue(result.complete, @"");
+  XCTAssertEqual(result.constraints, (NSUInteger)4, @"");
+  XCTAssertGreaterThan(result.operations, (NSUInteger)4, @"");
+  XCTAssertNil([ALKLayoutRecorder activeRecorder], @"");
+}
+
+- (void)testReplayFollowsReparentedViews
+{
+  UIView *firstParentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+  UIView *secondParentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+  UIView *childView = [self newEmptyView];
+  [firstParentView addSubview:childView];
+  
+  ALKLayoutRecorder *recorder = [ALKLayoutRecorder startRecording];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c make:ALKTop equalTo:firstParentView s:ALKTop];
+  }];
+  
+  [secondParentView addSubview:childView];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c make:ALKLeft equalTo:secondParentView s:ALKLeft];
+  }];
+  
+  ALKLayoutReplayResult result = [ALKLayoutRecorder replay:[recorder stopRecording]];
+  
+  XCTAssertTrue(result.complete, @"");
+  XCTAssertEqual(result.constraints, (NSUInteger)2, @"");
+  XCTAssertEqual(result.skippedConstraints, (NSUInteger)0, @"");
+}
+
+- (void)testReplayFollowsRelayoutsAndVariantSwitches
+{
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+  UIView *childView = [[UIView alloc] initWithFrame:CGRectZero];
+  [parentView addSubview:childView];
+  
+  ALKLayoutRecorder *recorder = [ALKLayoutRecorder startRecording];
+  
+  [ALKConstraints relayout:childView do:^(ALKConstraints *c) {
+    [c make:ALKTop equalTo:parentView s:ALKTop];
+    [c set:ALKWidth to:100.f];
+    [c set:ALKHeight to:20.f];
+  }];
+  
+  // reuses top and width with new constants, the height conflicts with the bottom unless it is deactivated
+  [ALKConstraints relayout:childView do:^(ALKConstraints *c) {
+    [c make:ALKTop equalTo:parentView s:ALKTop plus:30.f];
+    [c set:ALKWidth to:200.f];
+    [c make:ALKBottom equalTo:parentView s:ALKBottom minus:100.f];
+  }];
+  
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    [c variant:@"left" on:parentView do:^(ALKConstraints *c) {
+      [c make:ALKLeft equalTo:parentView s:ALKLeft plus:10.f];
+    }];
+    [c variant:@"right" on:parentView do:^(ALKConstraints *c) {
+      [c make:ALKRight equalTo:parentView s:ALKRight minus:10.f];
+    }];
+  }];
+  
+  ALKLayoutVariants *variants = [ALKLayoutVariants variantsOfView:parentView];
+  [variants switchToVariant:@"left"];
+  [variants switchToVariant:@"right"];
+  
+  [parentView layoutIfNeeded];
+  CGRect expected = childView.frame;
+  XCTAssertTrue(CGRectEqualToRect(expected, CGRectMake(110.f, 30.f, 200.f, 350.f)), @"%@", NSStringFromCGRect(expected));
+  
+  NSArray<UIView *> *rootViews = nil;
+  ALKLayoutReplayResult result = [ALKLayoutRecorder replay:[recorder stopRecording] rootViews:&rootViews];
+  
+  XCTAssertTrue(result.complete, @"");
+  XCTAssertEqual([rootViews count], (NSUInteger)1, @"");
+  
+  UIView *replayedChildView = [rootViews.firstObject.subviews firstObject];
+  XCTAssertTrue(CGRectEqualToRect(replayedChildView.frame, expected), @"%@", NSStringFromCGRect(replayedChildView.frame));
+  XCTAssertEqual([rootViews.firstObject.constraints count], [parentView.constraints count], @"");
+}
+
+- (void)testReplayStopsAtMalformedData
+{
+  ALKLayoutRecorder *recorder = [ALKLayoutRecorder startRecording];
+  
+  [ALKConstraints layout:[self newEmptyView] do:^(ALKConstraints *c) {
+    [c set:ALKWidth to:100.f];
+  }];
+  
+  NSData *session = [recorder stopRecording];
+  NSData *truncated = [session subdataWithRange:NSMakeRange(0, session.length - 2)];
+  
+  XCTAssertTrue([ALKLayoutRecorder replay:session].complete, @"");
+  XCTAssertFalse([ALKLayoutRecorder replay:truncated].complete, @"");
+  XCTAssertFalse([ALKLayoutRecorder replay:[NSData data]].complete, @"");
+}
+
+@end
@@ -0,0 +1,118 @@
+//  ResolutionTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface ResolutionTests : ALKTestCase
+
+@end
+
+@implementation ResolutionTests
+
+- (void)tearDown
+{
+  [ALKConstraints setConstantResolution:0];
+  [super tearDown];
+}
+
+- (void)testConstantsAreUsedAsGivenByDefault
+{
+  UIView *view = [self newEmptyView];
+  
+  __block NSLayoutConstraint *width = nil;
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    width = [c set:ALKWidth to:10.3f];
+  }];
+  
+  XCTAssertEqual([ALKConstraints constantResolution], (NSUInteger)0, @"");
+  XCTAssertEqual(width.constant, (CGFloat)10.3f, @"");
+}
+
+- (void)testSnapsToFixedPointGrid
+{
+  [ALKConstraints setConstantResolution:64];
+  
+  XCTAssertEqual([ALKConstraints snappedConstant:10.3f], (CGFloat)(659.0 / 64.0), @"");
+  XCTAssertEqual([ALKConstraints snappedConstant:-10.3f], (CGFloat)(-659.0 / 64.0), @"");
+  XCTAssertEqual([ALKConstraints snappedConstant:8.f], (CGFloat)8.f, @"");
+}
+
+- (void)testSnapsToPixels
+{
+  [ALKConstraints setConstantResolution:2];
+  
+  UIView *parentView = [self newTwoTierViewHierarchy];
+  UIView *childView = [parentView viewWithTag:tag];
+  
+  __block NSLayoutConstraint *left = nil;
+  __block NSLayoutConstraint *right = nil;
+  [ALKConstraints layout:childView do:^(ALKConstraints *c) {
+    left = [c make:ALKLeft equalTo:parentView s:ALKLeft plus:10.3f];
+    right = [c make:ALKRight equalTo:parentView s:ALKRight minus:.2f];
+  }];
+  
+  XCTAssertEqual(left.constant, (CGFloat)10.5f, @"");
+  XCTAssertEqual(right.constant, (CGFloat)0.f, @"");
+}
+
+- (void)testDifferentlyComputedConstantsAreShared
+{
+  [ALKConstraints setConstantResolution:64];
+  
+  UIView *view = [self newEmptyView];
+  CGFloat third = 1.f / 3.f;
+  
+  __block NSLayoutConstraint *first = nil;
+  __block NSLayoutConstraint *second = nil;
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    [c shareConstraints];
+    first = [c set:ALKWidth to:third * 3.f * 100.f];
+    second = [c set:ALKWidth to:100.f + 1e-5f];
+  }];
+  
+  XCTAssertEqual(first, second, @"");
+  XCTAssertEqual(first.constant, (CGFloat)100.f, @"");
+}
+
+- (void)testNamedConstantsAreSnapped
+{
+  [ALKConstraints setConstantResolution:4];
+  
+  UIView *view = [self newEmptyView];
+  [ALKConstraints layout:view do:^(ALKConstraints *c) {
+    [c set:ALKWidth to:10.f name:@"width"];
+    [c set:ALKHeight to:10.f name:@"height"];
+  }];
+  
+  [view alk_setConstant:20.1f forConstraintWithName:@"width"];
+  XCTAssertEqual([view alk_constraintWithName:@"width"].constant, (CGFloat)20.f, @"");
+  
+  // 10.05 snaps back to the current constant, so nothing changes
+  XCTAssertEqual([view alk_setConstants:@{ @"height": @10.05 }], (NSUInteger)0, @"");
+  XCTAssertEqual([view alk_setConstants:@{ @"height": @10.2 }], (NSUInteger)1, @"");
+  XCTAssertEqual([view alk_constraintWithName:@"height"].constant, (CGFloat)10.25f, @"");
+}
+
+@end
@@ -0,0 +1,178 @@
+//  SnapshotTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface SnapshotTests : ALKTestCase
+
+@property (nonatomic, strong) UIView *parentView;
+@property (nonatomic, strong) UIView *leftView;
+@property (nonatomic, strong) UIView *rightView;
+
+@end
+
+@implementation SnapshotTests
+
+- (void)setUp
+{
+  [super setUp];
+  
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 200.f, 100.f)];
+  UIView *leftView = [[UIView alloc] initWithFrame:CGRectZero];
+  UIView *rightView = [[UIView alloc] initWithFrame:CGRectZero];
+  [parentView addSubview:leftView];
+  [parentView addSubview:rightView];
+  
+  [ALKConstraints layout:leftView do:^(ALKConstraints *c) {
+    [c make:ALKLeft equalTo:parentView s:ALKLeft plus:10.f name:@"left"];
+    [c make:ALKTop equalTo:parentView s:ALKTop];
+    [c set:ALKWidth to:50.f name:@"width"];
+    [c set:ALKHeight to:20.f];
+  }];
+  
+  [ALKConstraints layout:rightView do:^(ALKConstraints *c) {
+    [c make:ALKRight equalTo:parentView s:ALKRight minus:10.f];
+    [c make:ALKTop equalTo:parentView s:ALKTop];
+    [c set:ALKWidth to:30.f];
+    [c set:ALKHeight to:20.f];
+  }];
+  
+  [parentView layoutIfNeeded];
+  
+  self.parentView = parentView;
+  self.leftView = leftView;
+  self.rightView = rightView;
+}
+
+- (void)tearDown
+{
+  self.parentView = nil;
+  self.leftView = nil;
+  self.rightView = nil;
+  [super tearDown];
+}
+
+- (void)testCapturesConstraintsAndFrames
+{
+  ALKLayoutSnapshot *snapshot = [ALKLayoutSnapshot snapshotOfView:self.parentView];
+  
+  XCTAssertEqual(snapshot.viewCount, (NSUInteger)3, @"");
+  XCTAssertEqual(snapshot.constraintCount, (NSUInteger)8, @"");
+  XCTAssertEqual(snapshot.sharedViewCount, (NSUInteger)0, @"");
+  XCTAssertTrue(CGRectEqualToRect([snapshot frameOfView:self.leftView], CGRectMake(10.f, 0.f, 50.f, 20.f)), @"");
+  XCTAssertTrue(CGRectEqualToRect([snapshot frameOfView:self.rightView], CGRectMake(160.f, 0.f, 30.f, 20.f)), @"");
+  XCTAssertTrue(CGRectIsNull([snapshot frameOfView:[self newEmptyView]]), @"");
+}
+
+- (void)testRestoringUnchangedLayoutChangesNothing
+{
+  ALKLayoutSnapshot *snapshot = [ALKLayoutSnapshot snapshotOfView:self.parentView];
+  XCTAssertEqual([snapshot restore], (NSUInteger)0, @"");
+}
+
+- (void)testRestoresEditedLayout
+{
+  ALKLayoutSnapshot *snapshot = [ALKLayoutSnapshot snapshotOfView:self.parentView];
+  NSLayoutConstraint *left = [self.parentView alk_constraintWithName:@"left"];
+  NSLayoutConstraint *width = [self.leftView alk_constraintWithName:@"width"];
+  
+  // preview: different constants, one named constraint replaced, one extra constraint
+  [self.parentView alk_setConstant:40.f forConstraintWithName:@"left"];
+  [self.leftView alk_removeConstraintWithName:@"width"];
+  UIView *parentView = self.parentView;
+  [ALKConstraints layout:self.leftView do:^(ALKConstraints *c) {
+    [c make:ALKRight equalTo:parentView s:ALKCenterX];
+  }];
+  [self.parentView layoutIfNeeded];
+  XCTAssertEqual(self.leftView.frame.size.width, (CGFloat)60.f, @"");
+  
+  // the constant, the removed width, the extra right edge
+  XCTAssertEqual([snapshot restore], (NSUInteger)3, @"");
+  [self.parentView layoutIfNeeded];
+  
+  XCTAssertEqual([self.parentView alk_constraintWithName:@"left"], left, @"");
+  XCTAssertEqual([self.leftView alk_constraintWithName:@"width"], width, @"");
+  XCTAssertEqual(left.constant, (CGFloat)10.f, @"");
+  XCTAssertTrue(width.active, @"");
+  XCTAssertTrue(CGRectEqualToRect(self.leftView.frame, [snapshot frameOfView:self.leftView]), @"");
+  XCTAssertTrue(CGRectEqualToRect(self.rightView.frame, [snapshot frameOfView:self.rightView]), @"");
+}
+
+- (void)testSharesUnchangedViews
+{
+  ALKLayoutSnapshot *editing = [ALKLayoutSnapshot snapshotOfView:self.parentView];
+  
+  [self.leftView alk_setConstant:80.f forConstraintWithName:@"width"];
+  [self.parentView layoutIfNeeded];
+  
+  ALKLayoutSnapshot *preview = [ALKLayoutSnapshot snapshotOfView:self.parentView sharingWith:editing];
+  
+  // only the left view changed, its constraint and its frame
+  XCTAssertEqual(preview.sharedViewCount, (NSUInteger)2, @"");
+  XCTAssertEqual(preview.constraintCount, editing.constraintCount, @"");
+  
+  [editing restore];
+  [self.parentView layoutIfNeeded];
+  XCTAssertEqual(self.leftView.frame.size.width, (CGFloat)50.f, @"");
+  
+  [preview restore];
+  [self.parentView layoutIfNeeded];
+  XCTAssertEqual(self.leftView.frame.size.width, (CGFloat)80.f, @"");
+}
+
+- (void)testReinstalledConstraintsStayUnchanged
+{
+  ALKLayoutSnapshot *snapshot = [ALKLayoutSnapshot snapshotOfView:self.parentView];
+  
+  // reactivating moves the constraint to the end of the installed constraints
+  NSLayoutConstraint *width = [self.rightView.constraints firstObject];
+  width.active = NO;
+  width.active = YES;
+  
+  ALKLayoutSnapshot *reordered = [ALKLayoutSnapshot snapshotOfView:self.parentView sharingWith:snapshot];
+  
+  XCTAssertEqual(reordered.sharedViewCount, (NSUInteger)3, @"");
+  XCTAssertEqual([snapshot restore], (NSUInteger)0, @"");
+}
+
+- (void)testRestoresPriorityAcrossRequired
+{
+  __block NSLayoutConstraint *height = nil;
+  [ALKConstraints layout:self.rightView do:^(ALKConstraints *c) {
+    [c setPriority:UILayoutPriorityDefaultHigh];
+    height = [c set:ALKHeight to:40.f];
+  }];
+  
+  ALKLayoutSnapshot *snapshot = [ALKLayoutSnapshot snapshotOfView:self.parentView];
+  
+  height.active = NO;
+  height.priority = UILayoutPriorityRequired;
+  
+  XCTAssertEqual([snapshot restore], (NSUInteger)2, @"");
+  XCTAssertTrue(height.active, @"");
+  XCTAssertEqual(height.priority, UILayoutPriorityDefaultHigh, @"");
+}
+
+@end
@@ -0,0 +1,237 @@
+//  SpecTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+// The matrix of LayoutTests expressed as `ALKConstraintSpec` tables. Every
+// case relates the child (item 1) to its parent (item 0), which is laid out
+// with a fixed frame so that the solved child frame can be checked as well.
+
+static CGRect const kALKSpecParentFrame = { { 0.f, 0.f }, { 200.f, 100.f } };
+static CGFloat const kALKSpecChildWidth = 20.f;
+static CGFloat const kALKSpecChildHeight = 10.f;
+
+static ALKAttribute const kALKSpecAttributes[] = {
+  ALKLeft, ALKRight, ALKTop, ALKBottom, ALKLeading, ALKTrailing,
+  ALKWidth, ALKHeight, ALKCenterX, ALKCenterY, ALKBaseline
+};
+
+static ALKRelation const kALKSpecRelations[] = { ALKEqualTo, ALKLessThan, ALKGreaterThan };
+
+// plain, times, plus, minus, times + plus and times + minus
+static CGFloat const kALKSpecMultipliers[] = { 1.f, .5f, 1.f, 1.f, .5f, .5f };
+static CGFloat const kALKSpecConstants[] = { 0.f, 0.f, 12.f, -12.f, 12.f, -12.f };
+
+#define ALK_COUNT(array) (sizeof(array) / sizeof(array[0]))
+
+@interface SpecTests : ALKTestCase
+
+@end
+
+@implementation SpecTests
+
+#pragma mark - Helper
+
+- (BOOL)isHorizontal:(ALKAttribute)attribute
+{
+  return attribute == ALKLeft || attribute == ALKRight || attribute == ALKLeading
+      || attribute == ALKTrailing || attribute == ALKCenterX || attribute == ALKWidth;
+}
+
+- (CGFloat)valueOfAttribute:(ALKAttribute)attribute inFrame:(CGRect)frame
+{
+  switch (attribute) {
+    case ALKLeft:
+    case ALKLeading:  return CGRectGetMinX(frame);
+    case ALKRight:
+    case ALKTrailing: return CGRectGetMaxX(frame);
+    case ALKCenterX:  return CGRectGetMidX(frame);
+    case ALKWidth:    return CGRectGetWidth(frame);
+    case ALKTop:      return CGRectGetMinY(frame);
+    case ALKBottom:
+    case ALKBaseline: return CGRectGetMaxY(frame);
+    case ALKCenterY:  return CGRectGetMidY(frame);
+    case ALKHeight:   return CGRectGetHeight(frame);
+    default:          return 0.f;
+  }
+}
+
+// The child frame in which `attribute` has `value` and everything else is
+// pinned by the complementary specs of `-caseWithSpec:`.
+- (CGRect)frameWithAttribute:(ALKAttribute)attribute value:(CGFloat)value
+{
+  CGRect frame = CGRectMake(0.f, 0.f, kALKSpecChildWidth, kALKSpecChildHeight);
+  switch (attribute) {
+    case ALKLeft:
+    case ALKLeading:  frame.origin.x = value; break;
+    case ALKRight:
+    case ALKTrailing: frame.origin.x = value - kALKSpecChildWidth; break;
+    case ALKCenterX:  frame.origin.x = value - kALKSpecChildWidth / 2.f; break;
+    case ALKWidth:    frame.size.width = value; break;
+    case ALKTop:      frame.origin.y = value; break;
+    case ALKBottom:
+    case ALKBaseline: frame.origin.y = value - kALKSpecChildHeight; break;
+    case ALKCenterY:  frame.origin.y = value - kALKSpecChildHeight / 2.f; break;
+    case ALKHeight:   frame.size.height = value; break;
+    default:          break;
+  }
+  return frame;
+}
+
+// The spec under test, completed so that the child frame is unambiguous.
+// Inequalities are pulled beyond their bound by a weak equality, so the
+// solved frame sits exactly on the bound.
+- (NSUInteger)caseWithSpec:(ALKConstraintSpec)spec into:(ALKConstraintSpec *)specs
+{
+  BOOL horizontal = [self isHorizontal:spec.attribute];
+  NSUInteger count = 0;
+  
+  specs[count++] = spec;
+  
+  if (spec.relation != ALKEqualTo) {
+    CGFloat pull = (spec.relation == ALKLessThan) ? 1000.f : -1000.f;
+    specs[count++] = (ALKConstraintSpec){ 1, spec.attribute, ALKEqualTo, 0, spec.attribute, 1.f, pull, UILayoutPriorityDefaultLow, NULL };
+  }
+  
+  if (horizontal) {
+    specs[count++] = (ALKConstraintSpec){ 1, ALKTop, ALKEqualTo, 0, ALKTop, 1.f, 0.f, UILayoutPriorityRequired, NULL };
+    specs[count++] = (ALKConstraintSpec){ 1, ALKHeight, ALKEqualTo, ALKSpecNoItem, ALKNone, 1.f, kALKSpecChildHeight, UILayoutPriorityRequired, NULL };
+    if (spec.attribute == ALKWidth) {
+      specs[count++] = (ALKConstraintSpec){ 1, ALKLeft, ALKEqualTo, 0, ALKLeft, 1.f, 0.f, UILayoutPriorityRequired, NULL };
+    } else {
+      specs[count++] = (ALKConstraintSpec){ 1, ALKWidth, ALKEqualTo, ALKSpecNoItem, ALKNone, 1.f, kALKSpecChildWidth, UILayoutPriorityRequired, NULL };
+    }
+  } else {
+    specs[count++] = (ALKConstraintSpec){ 1, ALKLeft, ALKEqualTo, 0, ALKLeft, 1.f, 0.f, UILayoutPriorityRequired, NULL };
+    specs[count++] = (ALKConstraintSpec){ 1, ALKWidth, ALKEqualTo, ALKSpecNoItem, ALKNone, 1.f, kALKSpecChildWidth, UILayoutPriorityRequired, NULL };
+    if (spec.attribute == ALKHeight) {
+      specs[count++] = (ALKConstraintSpec){ 1, ALKTop, ALKEqualTo, 0, ALKTop, 1.f, 0.f, UILayoutPriorityRequired, NULL };
+    } else {
+      specs[count++] = (ALKConstraintSpec){ 1, ALKHeight, ALKEqualTo, ALKSpecNoItem, ALKNone, 1.f, kALKSpecChildHeight, UILayoutPriorityRequired, NULL };
+    }
+  }
+  
+  return count;
+}
+
+- (void)enumerateMatrix:(void (^)(ALKConstraintSpec spec))block
+{
+  for (NSUInteger a = 0; a < ALK_COUNT(kALKSpecAttributes); a++) {
+    for (NSUInteger r = 0; r < ALK_COUNT(kALKSpecRelations); r++) {
+      for (NSUInteger f = 0; f < ALK_COUNT(kALKSpecMultipliers); f++) {
+        for (NSUInteger named = 0; named < 2; named++) {
+          ALKAttribute attribute = kALKSpecAttributes[a];
+          block((ALKConstraintSpec){ 1, attribute, kALKSpecRelations[r], 0, attribute,
+                                     kALKSpecMultipliers[f], kALKSpecConstants[f],
+                                     UILayoutPriorityRequired, named ? "ALKSpecTestConstraint" : NULL });
+        }
+      }
+    }
+  }
+}
+
+#pragma mark - Set
+
+- (void)testSetSpecs
+{
+  ALKAttribute const attributes[] = { ALKWidth, ALKHeight };
+  
+  for (NSUInteger a = 0; a < ALK_COUNT(attributes); a++) {
+    UIView *view = [self newEmptyView];
+    ALKConstraintSpec specs[] = {
+      { 0, attributes[a], ALKEqualTo, ALKSpecNoItem, ALKNone, 1.f, 3.f, UILayoutPriorityRequired, "ALKSpecTestConstraint" }
+    };
+    
+    NSArray *constraints = [ALKConstraints apply:specs count:1 items:@[view]];
+    
+    [self checkConstraint:constraints[0]
+                 withItem:view
+                attribute:(NSLayoutAttribute)attributes[a]
+                relatedBy:NSLayoutRelationEqual
+                   toItem:nil
+                attribute:NSLayoutAttributeNotAnAttribute
+               multiplier:1.f
+                 constant:3.f];
+    XCTAssertEqual([view alk_constraintWithName:@"ALKSpecTestConstraint"], constraints[0], @"");
+  }
+}
+
+#pragma mark - Make
+
+- (void)testMakeSpecFields
+{
+  __block NSUInteger cases = 0;
+  
+  [self enumerateMatrix:^(ALKConstraintSpec spec) {
+    UIView *parentView = [self newTwoTierViewHierarchy];
+    UIView *childView = [parentView viewWithTag:tag];
+    
+    NSArray *constraints = [ALKConstraints apply:&spec count:1 items:@[parentView, childView]];
+    
+    [self checkConstraint:constraints[0]
+                 withItem:childView
+                attribute:(NSLayoutAttribute)spec.attribute
+                relatedBy:(NSLayoutRelation)spec.relation
+                   toItem:parentView
+                attribute:(NSLayoutAttribute)spec.relatedAttribute
+               multiplier:spec.multiplier
+                 constant:spec.constant];
+    XCTAssertTrue([parentView.constraints containsObject:constraints[0]], @"");
+    
+    if (spec.name) {
+      XCTAssertEqual([parentView alk_constraintWithName:@(spec.name)], constraints[0], @"");
+    }
+    cases++;
+  }];
+  
+  XCTAssertEqual(cases, (NSUInteger)(11 * 3 * 6 * 2), @"");
+}
+
+- (void)testMakeSpecFrames
+{
+  [self enumerateMatrix:^(ALKConstraintSpec spec) {
+    // the baseline of a plain view depends on the SDK, it is covered by the field test
+    if (spec.attribute == ALKBaseline) return;
+    
+    UIView *parentView = [[UIView alloc] initWithFrame:kALKSpecParentFrame];
+    UIView *childView = [[UIView alloc] initWithFrame:CGRectZero];
+    [parentView addSubview:childView];
+    
+    ALKConstraintSpec specs[5];
+    NSUInteger count = [self caseWithSpec:spec into:specs];
+    [ALKConstraints apply:specs count:count items:@[parentView, childView]];
+    [parentView layoutIfNeeded];
+    
+    CGFloat bound = spec.multiplier * [self valueOfAttribute:spec.relatedAttribute inFrame:kALKSpecParentFrame] + spec.constant;
+    CGRect expected = [self frameWithAttribute:spec.attribute value:bound];
+    
+    XCTAssertTrue(CGRectEqualToRect(childView.frame, expected),
+                  @"attribute %ld relation %ld multiplier %.1f constant %.1f: %@ != %@",
+                  (long)spec.attribute, (long)spec.relation, spec.multiplier, spec.constant,
+                  NSStringFromCGRect(childView.frame), NSStringFromCGRect(expected));
+  }];
+}
+
+@end
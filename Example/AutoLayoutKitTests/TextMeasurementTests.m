@@ -0,0 +1,152 @@
+//  TextMeasurementTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface TextMeasurementTests : ALKTestCase
+
+@property (nonatomic, strong) ALKTextMeasurementCache *cache;
+@property (nonatomic, assign) NSUInteger measureCount;
+
+@end
+
+@implementation TextMeasurementTests
+
+- (void)setUp
+{
+  [super setUp];
+  
+  self.cache = [[ALKTextMeasurementCache alloc] init];
+  self.measureCount = 0;
+}
+
+- (void)tearDown
+{
+  self.cache = nil;
+  
+  [super tearDown];
+}
+
+- (CGSize)sizeOfText:(NSString *)text width:(CGFloat)width
+{
+  return [self sizeOfText:text attributes:@"body" width:width];
+}
+
+- (CGSize)sizeOfText:(NSString *)text attributes:(NSString *)attributes width:(CGFloat)width
+{
+  // stand-in measurer: every character is 10pt wide, every line 20pt high
+  return [self.cache sizeOfText:text attributes:attributes width:width measure:^CGSize(CGFloat width) {
+    self.measureCount += 1;
+    NSUInteger charactersPerLine = MAX((NSUInteger)1, (NSUInteger)(width / 10.f));
+    NSUInteger lines = MAX((NSUInteger)1, (text.length + charactersPerLine - 1) / charactersPerLine);
+    return CGSizeMake(MIN(text.length, charactersPerLine) * 10.f, lines * 20.f);
+  }];
+}
+
+- (void)testRepeatedRequestIsMeasuredOnce
+{
+  CGSize size = [self sizeOfText:@"0123456789" width:50.f];
+  XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(50.f, 40.f)), @"");
+  
+  size = [self sizeOfText:@"0123456789" width:50.f];
+  XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(50.f, 40.f)), @"");
+  XCTAssertEqual(self.measureCount, (NSUInteger)1, @"");
+  XCTAssertEqual(self.cache.hitCount, (NSUInteger)1, @"");
+  XCTAssertEqual(self.cache.missCount, (NSUInteger)1, @"");
+  XCTAssertEqualWithAccuracy(self.cache.hitRate, 0.5, 0.0001, @"");
+}
+
+- (void)testTextAttributesAndWidthAreKeys
+{
+  [self sizeOfText:@"0123456789" width:50.f];
+  [self sizeOfText:@"0123456780" width:50.f];
+  [self sizeOfText:@"0123456789" attributes:@"title" width:50.f];
+  [self sizeOfText:@"0123456789" width:30.f];
+  
+  XCTAssertEqual(self.measureCount, (NSUInteger)4, @"");
+  XCTAssertEqual(self.cache.count, (NSUInteger)3, @"");
+}
+
+- (void)testNarrowerWidthIsServedFromWiderMeasurement
+{
+  CGSize size = [self sizeOfText:@"01234" width:200.f];
+  XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(50.f, 20.f)), @"");
+  
+  // still fits into one line
+  size = [self sizeOfText:@"01234" width:60.f];
+  XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(50.f, 20.f)), @"");
+  XCTAssertEqual(self.measureCount, (NSUInteger)1, @"");
+  XCTAssertEqual(self.cache.narrowedHitCount, (NSUInteger)1, @"");
+  
+  // needs to break
+  size = [self sizeOfText:@"01234" width:40.f];
+  XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(40.f, 40.f)), @"");
+  XCTAssertEqual(self.measureCount, (NSUInteger)2, @"");
+}
+
+- (void)testLeastRecentlyUsedTextIsEvicted
+{
+  self.cache.countLimit = 2;
+  
+  [self sizeOfText:@"a" width:50.f];
+  [self sizeOfText:@"b" width:50.f];
+  [self sizeOfText:@"a" width:50.f];
+  [self sizeOfText:@"c" width:50.f];
+  XCTAssertEqual(self.cache.count, (NSUInteger)2, @"");
+  XCTAssertEqual(self.measureCount, (NSUInteger)3, @"");
+  
+  [self sizeOfText:@"a" width:50.f];
+  XCTAssertEqual(self.measureCount, (NSUInteger)3, @"");
+  [self sizeOfText:@"b" width:50.f];
+  XCTAssertEqual(self.measureCount, (NSUInteger)4, @"");
+}
+
+- (void)testMutatedTextIsNotServedFromCache
+{
+  NSMutableString *text = [NSMutableString stringWithString:@"01234"];
+  [self sizeOfText:text width:200.f];
+  [text appendString:@"56789"];
+  
+  CGSize size = [self sizeOfText:text width:200.f];
+  XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(100.f, 20.f)), @"");
+  XCTAssertEqual(self.measureCount, (NSUInteger)2, @"");
+}
+
+- (void)testRemoveAllMeasurementsAndResetStatistics
+{
+  [self sizeOfText:@"a" width:50.f];
+  [self sizeOfText:@"a" width:50.f];
+  [self.cache removeAllMeasurements];
+  [self.cache resetStatistics];
+  
+  XCTAssertEqual(self.cache.count, (NSUInteger)0, @"");
+  XCTAssertEqual(self.cache.hitCount, (NSUInteger)0, @"");
+  XCTAssertEqual(self.cache.missCount, (NSUInteger)0, @"");
+  
+  [self sizeOfText:@"a" width:50.f];
+  XCTAssertEqual(self.measureCount, (NSUInteger)2, @"");
+}
+
+@end
@@ -0,0 +1,199 @@
+//  TransitionTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface TransitionTests : ALKTestCase
+
+@property (nonatomic, strong) UIView *parentView;
+@property (nonatomic, strong) UIView *movingView;
+@property (nonatomic, strong) UIView *staticView;
+
+@end
+
+@implementation TransitionTests
+
+- (void)setUp
+{
+  [super setUp];
+  
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 200.f, 100.f)];
+  UIView *movingView = [[UIView alloc] initWithFrame:CGRectZero];
+  UIView *staticView = [[UIView alloc] initWithFrame:CGRectZero];
+  [parentView addSubview:movingView];
+  [parentView addSubview:staticView];
+  
+  [ALKConstraints layout:movingView do:^(ALKConstraints *c) {
+    [c make:ALKLeft equalTo:parentView s:ALKLeft name:@"left"];
+    [c make:ALKTop equalTo:parentView s:ALKTop];
+    [c set:ALKWidth to:50.f];
+    [c set:ALKHeight to:20.f];
+  }];
+  
+  [ALKConstraints layout:staticView do:^(ALKConstraints *c) {
+    [c make:ALKLeft equalTo:parentView s:ALKLeft];
+    [c make:ALKBottom equalTo:parentView s:ALKBottom];
+    [c set:ALKWidth to:50.f];
+    [c set:ALKHeight to:20.f];
+  }];
+  
+  self.parentView = parentView;
+  self.movingView = movingView;
+  self.staticView = staticView;
+}
+
+- (void)tearDown
+{
+  self.parentView = nil;
+  self.movingView = nil;
+  self.staticView = nil;
+  [super tearDown];
+}
+
+- (ALKLayoutTransition *)newTransition
+{
+  UIView *parentView = self.parentView;
+  return [ALKLayoutTransition transitionOfView:parentView changes:^{
+    [parentView alk_setConstant:100.f forConstraintWithName:@"left"];
+  }];
+}
+
+- (void)testStartsAtStartLayout
+{
+  ALKLayoutTransition *transition = [self newTransition];
+  
+  XCTAssertEqual(transition.movingViewCount, (NSUInteger)1, @"");
+  XCTAssertEqual(transition.progress, (CGFloat)0.f, @"");
+  XCTAssertTrue(CGRectEqualToRect(self.movingView.frame, CGRectMake(0.f, 0.f, 50.f, 20.f)), @"");
+  XCTAssertTrue(CGRectEqualToRect(self.staticView.frame, CGRectMake(0.f, 80.f, 50.f, 20.f)), @"");
+}
+
+- (void)testInterpolatesFrames
+{
+  ALKLayoutTransition *transition = [self newTransition];
+  
+  transition.progress = .5f;
+  XCTAssertEqual(self.movingView.frame.origin.x, (CGFloat)50.f, @"");
+  XCTAssertEqual(self.movingView.frame.size.width, (CGFloat)50.f, @"");
+  
+  transition.progress = 1.5f;
+  XCTAssertEqual(self.movingView.frame.origin.x, (CGFloat)150.f, @"");
+  
+  XCTAssertTrue(CGRectEqualToRect(self.staticView.frame, CGRectMake(0.f, 80.f, 50.f, 20.f)), @"");
+}
+
+- (void)testFinishKeepsEndLayout
+{
+  ALKLayoutTransition *transition = [self newTransition];
+  transition.progress = .3f;
+  
+  [transition finish];
+  XCTAssertEqual(self.movingView.frame.origin.x, (CGFloat)100.f, @"");
+  
+  [self.parentView setNeedsLayout];
+  [self.parentView layoutIfNeeded];
+  XCTAssertEqual(self.movingView.frame.origin.x, (CGFloat)100.f, @"");
+}
+
+- (void)testCancelRestoresStartLayout
+{
+  ALKLayoutTransition *transition = [self newTransition];
+  transition.progress = .7f;
+  
+  [transition cancel];
+  XCTAssertEqual(transition.progress, (CGFloat)0.f, @"");
+  XCTAssertEqual([self.parentView alk_constraintWithName:@"left"].constant, (CGFloat)0.f, @"");
+  XCTAssertEqual(self.movingView.frame.origin.x, (CGFloat)0.f, @"");
+}
+
+- (void)testNestedViewsKeepFramesThroughLayoutPasses
+{
+  UIWindow *window = [[UIWindow alloc] initWithFrame:CGRectMake(0.f, 0.f, 200.f, 100.f)];
+  [window addSubview:self.parentView];
+  window.hidden = NO;
+  
+  UIView *containerView = [[UIView alloc] initWithFrame:CGRectZero];
+  UIView *nestedView = [[UIView alloc] initWithFrame:CGRectZero];
+  [self.parentView addSubview:containerView];
+  [containerView addSubview:nestedView];
+  
+  [ALKConstraints layout:containerView do:^(ALKConstraints *c) {
+    [c make:ALKLeft equalTo:self.parentView s:ALKLeft];
+    [c make:ALKTop equalTo:self.parentView s:ALKTop];
+    [c set:ALKWidth to:100.f name:@"width"];
+    [c set:ALKHeight to:50.f];
+  }];
+  
+  [ALKConstraints layout:nestedView do:^(ALKConstraints *c) {
+    [c make:ALKRight equalTo:containerView s:ALKRight];
+    [c make:ALKTop equalTo:containerView s:ALKTop];
+    [c set:ALKWidth to:20.f];
+    [c set:ALKHeight to:20.f];
+  }];
+  
+  UIView *parentView = self.parentView;
+  ALKLayoutTransition *transition = [ALKLayoutTransition transitionOfView:parentView changes:^{
+    [parentView alk_setConstant:200.f forConstraintWithName:@"width"];
+  }];
+  
+  for (NSUInteger step = 0; step <= 4; step++) {
+    CGFloat progress = (CGFloat)step / 4.f;
+    transition.progress = progress;
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:.05]];
+    
+    XCTAssertEqual(containerView.frame.size.width, 100.f + 100.f * progress, @"");
+    XCTAssertEqual(nestedView.frame.origin.x, 80.f + 100.f * progress, @"");
+  }
+  
+  window.hidden = YES;
+}
+
+- (void)testInterpolationOfManyViews
+{
+  UIView *parentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 1000.f, 1000.f)];
+  for (NSUInteger i = 0; i < 1000; i++) {
+    UIView *view = [[UIView alloc] initWithFrame:CGRectZero];
+    [parentView addSubview:view];
+    [ALKConstraints layout:view do:^(ALKConstraints *c) {
+      [c make:ALKLeft equalTo:parentView s:ALKLeft];
+      [c make:ALKTop equalTo:parentView s:ALKTop plus:(CGFloat)i];
+      [c make:ALKWidth equalTo:parentView s:ALKWidth times:.5f];
+      [c set:ALKHeight to:1.f];
+    }];
+  }
+  
+  ALKLayoutTransition *transition = [ALKLayoutTransition transitionOfView:parentView changes:^{
+    parentView.frame = CGRectMake(0.f, 0.f, 500.f, 1000.f);
+  }];
+  XCTAssertEqual(transition.movingViewCount, (NSUInteger)1000, @"");
+  
+  for (NSUInteger step = 0; step <= 60; step++) {
+    transition.progress = (CGFloat)step / 60.f;
+  }
+  
+  XCTAssertEqual([parentView.subviews lastObject].frame.size.width, (CGFloat)250.f, @"");
+}
+
+@end
@@ -0,0 +1,140 @@
+//  VariantTests.m
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "ALKTestCase.h"
+#import "AutoLayoutKit.h"
+
+@interface VariantTests : ALKTestCase
+
+@property (nonatomic, strong) UIView *parentView;
+@property (nonatomic, strong) UIView *childView;
+@property (nonatomic, strong) ALKLayoutVariants *variants;
+
+@end
+
+@implementation VariantTests
+
+- (void)setUp
+{
+  [super setUp];
+  
+  self.parentView = [[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)];
+  self.childView = [[UIView alloc] initWithFrame:CGRectZero];
+  [self.parentView addSubview:self.childView];
+  
+  [ALKConstraints layout:self.childView do:^(ALKConstraints *c) {
+    [c make:ALKTop equalTo:self.parentView s:ALKTop plus:10.f];
+    
+    [c variant:@"compact" on:self.parentView do:^(ALKConstraints *c) {
+      [c set:ALKHeight to:40.f];
+      [c set:ALKWidth to:40.f];
+      [c make:ALKLeft equalTo:self.parentView s:ALKLeft plus:10.f name:@"left"];
+    }];
+    
+    [c variant:@"regular" on:self.parentView do:^(ALKConstraints *c) {
+      [c set:ALKHeight to:40.f];
+      [c set:ALKWidth to:80.f];
+      [c make:ALKLeft equalTo:self.parentView s:ALKLeft plus:20.f name:@"left"];
+    }];
+  }];
+  
+  self.variants = [ALKLayoutVariants variantsOfView:self.parentView];
+}
+
+- (void)tearDown
+{
+  self.variants = nil;
+  self.childView = nil;
+  self.parentView = nil;
+  
+  [super tearDown];
+}
+
+- (void)testVariantsAreInactiveUntilSwitched
+{
+  XCTAssertNil(self.variants.currentVariant, @"");
+  XCTAssertEqualObjects(self.variants.variantTags, (@[ @"compact", @"regular" ]), @"");
+  XCTAssertEqual([self.variants constraintCountOfVariant:@"compact"], (NSUInteger)3, @"");
+  XCTAssertEqual(self.childView.constraints.count, (NSUInteger)0, @"");
+  XCTAssertEqual(self.parentView.constraints.count, (NSUInteger)1, @"");
+  XCTAssertNil([self.parentView alk_constraintWithName:@"left"], @"");
+}
+
+- (void)testSwitchingAppliesVariant
+{
+  XCTAssertEqual([self.variants switchToVariant:@"compact"], (NSUInteger)3, @"");
+  [self.parentView layoutIfNeeded];
+  XCTAssertTrue(CGRectEqualToRect(self.childView.frame, CGRectMake(10.f, 10.f, 40.f, 40.f)), @"");
+  XCTAssertEqual([self.parentView alk_constraintWithName:@"left"].constant, 10.f, @"");
+  
+  [self.variants switchToVariant:@"regular"];
+  [self.parentView layoutIfNeeded];
+  XCTAssertTrue(CGRectEqualToRect(self.childView.frame, CGRectMake(20.f, 10.f, 80.f, 40.f)), @"");
+  XCTAssertEqual([self.parentView alk_constraintWithName:@"left"].constant, 20.f, @"");
+  XCTAssertEqualObjects(self.variants.currentVariant, @"regular", @"");
+}
+
+- (void)testSwitchOnlyAppliesDelta
+{
+  [self.variants switchToVariant:@"compact"];
+  NSLayoutConstraint *height = nil;
+  for (NSLayoutConstraint *lc in self.childView.constraints) {
+    if (lc.firstAttribute == NSLayoutAttributeHeight) height = lc;
+  }
+  XCTAssertNotNil(height, @"");
+  
+  // the equal height is shared, width and left are swapped
+  XCTAssertEqual([self.variants switchToVariant:@"regular"], (NSUInteger)4, @"");
+  XCTAssertTrue(height.active, @"");
+  XCTAssertEqual([self.variants switchToVariant:@"regular"], (NSUInteger)0, @"");
+  XCTAssertEqual([self.variants switchToVariant:@"compact"], (NSUInteger)4, @"");
+  XCTAssertTrue(height.active, @"");
+}
+
+- (void)testSwitchingToNilDeactivatesAllVariants
+{
+  [self.variants switchToVariant:@"regular"];
+  XCTAssertEqual([self.variants switchToVariant:nil], (NSUInteger)3, @"");
+  XCTAssertEqual(self.childView.constraints.count, (NSUInteger)0, @"");
+  XCTAssertNil([self.parentView alk_constraintWithName:@"left"], @"");
+}
+
+- (void)testDeclaringCurrentVariantActivates
+{
+  [self.variants switchToVariant:@"compact"];
+  
+  __block NSLayoutConstraint *right = nil;
+  [ALKConstraints layout:self.childView do:^(ALKConstraints *c) {
+    [c variant:@"compact" on:self.parentView do:^(ALKConstraints *c) {
+      right = [c make:ALKRight lessThan:self.parentView s:ALKRight];
+    }];
+  }];
+  
+  XCTAssertTrue(right.active, @"");
+  XCTAssertEqual([self.variants constraintCountOfVariant:@"compact"], (NSUInteger)4, @"");
+  XCTAssertEqual([self.variants switchToVariant:@"regular"], (NSUInteger)5, @"");
+  XCTAssertFalse(right.active, @"");
+}
+
+@end
@@ -110,8 +110,7 @@ NSString * const kLKPTextFieldViewKeyboardHeight   = @"keyboardHeight";
                  animated:(BOOL)animated
         animationDuration:(NSTimeInterval)animationDuration
 {
-  NSLayoutConstraint *c = [self alk_constraintWithName:kLKPTextFieldViewKeyboardHeight];
-  c.constant = (-1) * height;
+  [self alk_setConstant:((-1) * height) forConstraintWithName:kLKPTextFieldViewKeyboardHeight];
   [self setNeedsUpdateConstraints];
   
   if (animated) {
@@ -185,6 +184,9 @@ NSString * const kLKPTextFieldViewKeyboardHeight   = @"keyboardHeight";
     [c make:ALKCenterX  equalTo:self.scrollView s:ALKCenterX];
     [c make:ALKBottom   equalTo:self.scrollView s:ALKBottom];
   }];
+  
+  // let the text view size its container in the same layout pass
+  [ALKLayoutFlattener flattenView:self maximumConstraintCount:16];
 }
 
 - (void)setupNotifications
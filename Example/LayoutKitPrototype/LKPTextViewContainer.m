@@ -87,7 +87,13 @@
 - (CGSize)textFieldSize
 {
   CGFloat fixedWidth = self.textView.frame.size.width;
-  CGSize newSize = [self.textView sizeThatFits:CGSizeMake(fixedWidth, MAXFLOAT)];
+  UITextView *textView = self.textView;
+  CGSize newSize = [[ALKTextMeasurementCache sharedCache] sizeOfText:(textView.text ?: @"")
+                                                          attributes:(textView.font ?: [NSNull null])
+                                                               width:fixedWidth
+                                                             measure:^CGSize(CGFloat width) {
+    return [textView sizeThatFits:CGSizeMake(width, MAXFLOAT)];
+  }];
   return CGSizeMake(fmaxf(newSize.width, fixedWidth), fmaxf(LKPTEXTFIELDMINHEIGHT, newSize.height));
 }
 
@@ -0,0 +1,139 @@
+//  SpecFieldTests.cpp
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+// The field half of the SpecTests matrix: every attribute, relation,
+// multiplier and constant written with the C++ front end must end up in the
+// right fields of its ALKConstraintSpec. Solving the specs needs UIKit, so the
+// frame checks stay in the simulator test bundle.
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <AutoLayoutKit/ALKLayoutDSL.h>
+
+using namespace alk;
+
+static const char * const kALKSpecName = "ALKSpecTestConstraint";
+
+// plain, times, plus, minus, times + plus and times + minus
+static const CGFloat kALKSpecMultipliers[] = { 1.0, 0.5, 1.0, 1.0, 0.5, 0.5 };
+static const CGFloat kALKSpecConstants[] = { 0.0, 0.0, 12.0, -12.0, 12.0, -12.0 };
+
+static unsigned failures = 0;
+static unsigned cases = 0;
+
+#define ALK_CHECK(condition, attribute, relation, factor) \
+  do { \
+    if (!(condition)) { \
+      failures++; \
+      std::fprintf(stderr, "%s:%d: attribute %ld relation %ld factor %u: %s\n", \
+                   __FILE__, __LINE__, (long)(attribute), (long)(relation), (factor), #condition); \
+    } \
+  } while (0)
+
+template <Axis A>
+static ALKConstraintSpec makeSpec(Anchor<A> anchor, Anchor<A> related, ALKRelation relation, CGFloat multiplier, CGFloat constant) {
+  Term<A> term = related * multiplier + constant;
+  switch (relation) {
+    case ALKLessThan:    return anchor <= term;
+    case ALKGreaterThan: return anchor >= term;
+    default:             return anchor == term;
+  }
+}
+
+template <Axis A>
+static void checkAttribute(Anchor<A> (*anchor)(uint8_t), ALKAttribute attribute) {
+  const ALKRelation relations[] = { ALKEqualTo, ALKLessThan, ALKGreaterThan };
+  
+  for (ALKRelation relation : relations) {
+    for (unsigned f = 0; f < sizeof(kALKSpecMultipliers) / sizeof(kALKSpecMultipliers[0]); f++) {
+      for (int named = 0; named < 2; named++) {
+        ALKConstraintSpec spec = makeSpec(anchor(1), anchor(0), relation, kALKSpecMultipliers[f], kALKSpecConstants[f]);
+        if (named) spec = alk::named(spec, kALKSpecName);
+        
+        ALK_CHECK(spec.item == 1, attribute, relation, f);
+        ALK_CHECK(spec.attribute == attribute, attribute, relation, f);
+        ALK_CHECK(spec.relation == relation, attribute, relation, f);
+        ALK_CHECK(spec.relatedItem == 0, attribute, relation, f);
+        ALK_CHECK(spec.relatedAttribute == attribute, attribute, relation, f);
+        ALK_CHECK(std::fabs(spec.multiplier - kALKSpecMultipliers[f]) < 0.001, attribute, relation, f);
+        ALK_CHECK(std::fabs(spec.constant - kALKSpecConstants[f]) < 0.001, attribute, relation, f);
+        ALK_CHECK(spec.priority == 1000.f, attribute, relation, f);
+        ALK_CHECK(named ? (spec.name && std::strcmp(spec.name, kALKSpecName) == 0) : spec.name == nullptr, attribute, relation, f);
+        cases++;
+      }
+    }
+  }
+}
+
+template <Axis A>
+static void checkConstant(Anchor<A> (*anchor)(uint8_t), ALKAttribute attribute) {
+  ALKConstraintSpec spec = alk::named(anchor(0) == 3, kALKSpecName);
+  
+  ALK_CHECK(spec.item == 0, attribute, ALKEqualTo, 0u);
+  ALK_CHECK(spec.attribute == attribute, attribute, ALKEqualTo, 0u);
+  ALK_CHECK(spec.relation == ALKEqualTo, attribute, ALKEqualTo, 0u);
+  ALK_CHECK(spec.relatedItem == ALKSpecNoItem, attribute, ALKEqualTo, 0u);
+  ALK_CHECK(spec.relatedAttribute == ALKNone, attribute, ALKEqualTo, 0u);
+  ALK_CHECK(std::fabs(spec.multiplier - 1.0) < 0.001, attribute, ALKEqualTo, 0u);
+  ALK_CHECK(std::fabs(spec.constant - 3.0) < 0.001, attribute, ALKEqualTo, 0u);
+}
+
+// tables are built at compile time
+static constexpr auto kALKSpecTable = layout(
+  left(1) == left(0) + 10,
+  size(width(1), 24),
+  priority(height(1) <= height(0) * 0.5, 750)
+);
+static_assert(kALKSpecTable.size() == 3, "one spec per expression");
+static_assert(kALKSpecTable[0].constant == 10, "constant of left(1) == left(0) + 10");
+static_assert(kALKSpecTable[1].relatedItem == ALKSpecNoItem, "a fixed size relates to no item");
+static_assert(kALKSpecTable[2].relation == ALKLessThan, "relation of height(1) <= height(0) * 0.5");
+static_assert(kALKSpecTable[2].priority == 750, "priority of height(1) <= height(0) * 0.5");
+
+int main() {
+  checkAttribute(left, ALKLeft);
+  checkAttribute(right, ALKRight);
+  checkAttribute(top, ALKTop);
+  checkAttribute(bottom, ALKBottom);
+  checkAttribute(leading, ALKLeading);
+  checkAttribute(trailing, ALKTrailing);
+  checkAttribute(width, ALKWidth);
+  checkAttribute(height, ALKHeight);
+  checkAttribute(centerX, ALKCenterX);
+  checkAttribute(centerY, ALKCenterY);
+  checkAttribute(baseline, ALKBaseline);
+  
+  checkConstant(width, ALKWidth);
+  checkConstant(height, ALKHeight);
+  
+  if (cases != 11 * 3 * 6 * 2) {
+    std::fprintf(stderr, "expected %d cases, ran %u\n", 11 * 3 * 6 * 2, cases);
+    failures++;
+  }
+  
+  std::printf("%u cases, %u failures\n", cases, failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+//  UIKit.h
+//  AutoLayoutKitTests
+//
+//  Copyright (c) 2013 Florian Krueger <florian.krueger@projectserver.org>
+//  Created on 19/10/26.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+// The few UIKit declarations `ALKConstraintSpec.h` needs, so that the
+// constraint tables of `ALKLayoutDSL.h` can be checked without an SDK. The
+// values match the iOS SDK.
+
+#ifndef ALK_PORTABLE_UIKIT_H
+#define ALK_PORTABLE_UIKIT_H
+
+#include <cstdint>
+
+#define _Nullable
+#define _Nonnull
+
+#define NS_ENUM(_type, _name) _type _name; enum : _type
+
+typedef long NSInteger;
+typedef double CGFloat;
+typedef float UILayoutPriority;
+
+typedef NS_ENUM(NSInteger, NSLayoutAttribute) {
+  NSLayoutAttributeLeft = 1,
+  NSLayoutAttributeRight,
+  NSLayoutAttributeTop,
+  NSLayoutAttributeBottom,
+  NSLayoutAttributeLeading,
+  NSLayoutAttributeTrailing,
+  NSLayoutAttributeWidth,
+  NSLayoutAttributeHeight,
+  NSLayoutAttributeCenterX,
+  NSLayoutAttributeCenterY,
+  NSLayoutAttributeLastBaseline,
+  NSLayoutAttributeBaseline = NSLayoutAttributeLastBaseline,
+  NSLayoutAttributeNotAnAttribute = 0
+};
+
+typedef NS_ENUM(NSInteger, NSLayoutRelation) {
+  NSLayoutRelationLessThanOrEqual = -1,
+  NSLayoutRelationEqual = 0,
+  NSLayoutRelationGreaterThanOrEqual = 1
+};
+
+#endif